@@ -1,59 +1,263 @@
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#if __has_include(<span>)
+#include <span> // Defines __cpp_lib_span from C++20 on
+#endif
+#include <thread>
+#include "parallel_scan.h"
+#include "simd_search.h"
+#include "value_index.h"
 using namespace std;
 
+/*
+Immutable view of the elements of an ArrayList at the time of ArrayList::snapshot().
+It shares the array of the list instead of copying it, and the list copies the
+array on its next modification while any snapshot is alive. Copies of a snapshot
+can be handed to other threads and read while the list keeps being modified.
+*/
+template <typename T>
+class ArrayListSnapshot
+{
+    shared_ptr<const T[]> buffer;
+    int length;
+    int current_index;
+
+public:
+    ArrayListSnapshot(shared_ptr<const T[]> buffer, int length, int current_index)
+        : buffer(move(buffer)), length(length), current_index(current_index) {}
+
+    int size() const
+    {
+        return length;
+    }
+
+    const T &operator[](int index) const
+    {
+        return buffer[index];
+    }
+
+    const T *begin() const
+    {
+        return buffer.get();
+    }
+
+    const T *end() const
+    {
+        return buffer.get() + length;
+    }
+
+    bool is_present(const T &value) const
+    {
+        return search(value) != -1;
+    }
+
+    // Returns the index of the first occurrence of value, or -1
+    int search(const T &value) const
+    {
+        return find_first_in(buffer.get(), length, value);
+    }
+
+    void print(ostream &out = cout) const
+    {
+        if (length == 0)
+            out << "[ . ]\n";
+        else
+        {
+            out << "[ ";
+            for (int i = 0; i < length; i++)
+            {
+                out << buffer[i];
+                if (i == current_index)
+                    out << "|";
+                out << " ";
+            }
+            out << "]\n";
+        }
+    }
+};
+
+#define PARALLEL_THRESHOLD (1 << 20) // Default size from which reverse, search and is_present use all cores
+
+template <typename T>
 class ArrayList
 {
-    int *array;
+public:
+    // Receives the old and the new capacity whenever the backing array is reallocated
+    typedef void (*CapacityCallback)(int old_capacity, int new_capacity);
+
+    // Iterators are plain pointers into the array, so they are invalidated by any
+    // insertion or deletion, like those of std::vector. None of them move the cursor.
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+private:
+    // capacity uninitialized slots, of which the first size hold elements. Elements are
+    // constructed in place and move-constructed into a new array on reallocation, so T
+    // needs no default constructor and empty slots cost nothing.
+    struct Storage
+    {
+        T *slots;
+        int capacity;
+        int size = 0; // Kept equal to the length of the list while the list owns the storage
+
+        Storage(int capacity) : slots(allocator<T>().allocate(capacity)), capacity(capacity) {}
+
+        Storage(const Storage &) = delete;
+        Storage &operator=(const Storage &) = delete;
+
+        ~Storage()
+        {
+            destroy_n(slots, size);
+            allocator<T>().deallocate(slots, capacity);
+        }
+    };
+
+    shared_ptr<Storage> buffer; // Shared with the snapshots taken since the last modification
+    T *array;                   // buffer->slots
     int capacity;
     int length;
     int current_index;
 
+    // Resize policy: grows by growth_factor once size >= grow_load * capacity and halves
+    // (down to min_capacity) once size < shrink_load * capacity. With a shrink_delay, the
+    // memory is only released after that many removals in a row left the list under shrink_load.
+    double growth_factor = 2.0;
+    double grow_load = 0.5;
+    double shrink_load = 0.25;
+    int min_capacity = 2;
+    int shrink_delay = 0;
+    int low_occupancy_streak = 0;
+    CapacityCallback on_capacity_change = nullptr;
+
+    long long reallocation_count = 0;
+    long long bytes_copied = 0;
+
+    ValueIndex<T> value_index;
+
+    int parallel_threads = max(1u, thread::hardware_concurrency());
+    int parallel_threshold = PARALLEL_THRESHOLD;
+
+    bool is_parallel()
+    {
+        return parallel_threads > 1 && length >= parallel_threshold;
+    }
+
+    int find_first_element(const T &value)
+    {
+        if (is_parallel())
+            return parallel_find_first(array, length, value, parallel_threads);
+        return find_first_in(array, length, value);
+    }
+
     void init()
     {
-        capacity = 2;
-        array = new int[capacity];
+        capacity = min_capacity;
+        buffer = make_shared<Storage>(capacity);
+        array = buffer->slots;
         length = 0;
         current_index = -1; // Empty array
+        low_occupancy_streak = 0;
     }
 
-    // Moves the elements to a new array of new_capacity
+    // Whether a snapshot still uses the array
+    bool is_shared()
+    {
+        if (buffer.use_count() == 1)
+        {
+            // Pairs with the release of the last snapshot, so its reads happen before our writes
+            atomic_thread_fence(memory_order_acquire);
+            return false;
+        }
+        return true;
+    }
+
+    // Move-constructs the elements in a new array of new_capacity (they are copied instead if a
+    // snapshot uses the array). Both lower to memmove for trivially copyable types.
+    // Move-only elements cannot be snapshotted, so they never take the copying path.
     void move_to_new_array(int new_capacity)
     {
-        int *new_array = new int[new_capacity];
-        for (int i = 0; i < length; i++)
+        if (on_capacity_change != nullptr && new_capacity != capacity)
+            on_capacity_change(capacity, new_capacity);
+
+        shared_ptr<Storage> new_buffer = make_shared<Storage>(new_capacity);
+        if constexpr (is_copy_constructible<T>::value)
         {
-            new_array[i] = array[i];
+            if (is_shared())
+                uninitialized_copy(array, array + length, new_buffer->slots);
+            else
+                uninitialized_move(array, array + length, new_buffer->slots);
         }
-        delete[] array;
-        array = new_array;
+        else
+            uninitialized_move(array, array + length, new_buffer->slots);
+        new_buffer->size = length;
+        buffer = move(new_buffer); // Destroys the moved-from elements unless a snapshot still uses them
+        array = buffer->slots;
         capacity = new_capacity;
+
+        reallocation_count++;
+        bytes_copied += (long long)length * sizeof(T);
+    }
+
+    // Copies the array before the first modification after a snapshot
+    void detach()
+    {
+        if (is_shared())
+            move_to_new_array(capacity);
+    }
+
+    // Capacity after one growth step, always at least one more than the current capacity
+    int grown_capacity()
+    {
+        int new_capacity = (int)(capacity * growth_factor);
+        return new_capacity > capacity ? new_capacity : capacity + 1;
     }
 
-    // Doubles the capacity if size >= half the capacity
+    // Grows the capacity by growth_factor if size >= grow_load of the capacity (half by default)
     void increase_capacity()
     {
-        if (length * 2 >= capacity)
-        {
-            cout << "Capacity increased from " << capacity << " to " << (capacity * 2) << endl;
-            move_to_new_array(capacity * 2);
-        }
+        if (length >= capacity * grow_load)
+            move_to_new_array(grown_capacity());
+        if (length >= capacity * shrink_load)
+            low_occupancy_streak = 0;
     }
 
-    // Halves the capacity if size < 25% of the capacity
+    // Halves the capacity if size < shrink_load of the capacity (25% by default),
+    // once shrink_delay removals in a row have stayed below it
     void decrease_capacity()
     {
-        if (length * 4 < capacity)
+        if (length >= capacity * shrink_load)
         {
-            cout << "Capacity decreased from " << capacity << " to " << (capacity / 2) << endl;
-            move_to_new_array(capacity / 2);
+            low_occupancy_streak = 0;
+            return;
         }
+        if (++low_occupancy_streak <= shrink_delay)
+            return;
+        low_occupancy_streak = 0;
+
+        // A delayed shrink may need several halvings, which are done with one reallocation
+        int new_capacity = capacity;
+        while (length < new_capacity * shrink_load)
+        {
+            int half = max(new_capacity / 2, min_capacity);
+            if (half >= new_capacity)
+                break;
+            new_capacity = half;
+        }
+        if (new_capacity < capacity)
+            move_to_new_array(new_capacity);
     }
 
     void move_current_index(int n)
     {
         if (length == 0)
             return;
-        
+
         int new_index = current_index + n;
         if (new_index < 0)
             current_index = 0;
@@ -68,21 +272,68 @@ class ArrayList
         return index >= 0 && index < length;
     }
 
-public:
-    ArrayList()
+    // Returned by find, update, delete_cur and trim when there is no such element:
+    // -1 for numbers (the lists are assumed to hold non-negative integers) and T() otherwise
+    static T missing_value()
     {
-        init();
+        if constexpr (is_arithmetic<T>::value)
+            return T(-1);
+        else
+            return T();
+    }
+
+    // Inserts n values from first after the current element, shifting the latter elements only once
+    template <typename Iterator>
+    void insert_at_cursor(Iterator first, int n)
+    {
+        if (n <= 0)
+            return;
+
+        reserve(length + n);
+        detach();
+
+        // The last n slots after the shift are uninitialized, the others hold elements
+        T *position = array + current_index + 1;
+        int after = length - (current_index + 1); // Elements that shift right
+        if (n <= after)
+        {
+            uninitialized_move(array + length - n, array + length, array + length);
+            move_backward(position, array + length - n, array + length);
+            copy(first, first + n, position);
+        }
+        else
+        {
+            uninitialized_move(position, array + length, position + n);
+            copy(first, first + after, position);
+            uninitialized_copy(first + after, first + n, array + length);
+        }
+        current_index += n;
+        length += n;
+        buffer->size = length;
+
+        value_index.invalidate();
     }
 
-    ~ArrayList()
+    // Calls visit(value, index) for every element, used to rebuild the value index
+    auto for_each_element()
     {
-        delete[] array;
+        return [this](auto visit)
+        {
+            for (int i = 0; i < length; i++)
+                visit(array[i], i);
+        };
+    }
+
+public:
+    ArrayList()
+    {
+        init();
     }
 
     void clear()
     {
-        delete[] array;
         init();
+        value_index.cleared();
     }
 
     int size()
@@ -90,93 +341,317 @@ public:
         return length;
     }
 
-    bool is_present(int value)
+    int get_capacity()
+    {
+        return capacity;
+    }
+
+    // Returns an immutable view of the current elements in O(1).
+    // Needs a copyable T, since the list copies the shared array on its next modification.
+    ArrayListSnapshot<T> snapshot()
     {
-        for (int i = 0; i < length; i++)
+        static_assert(is_copy_constructible<T>::value, "snapshot() copies the elements on the next modification");
+        // Aliases the storage, so the snapshot keeps it (and its elements) alive
+        return ArrayListSnapshot<T>(shared_ptr<const T[]>(buffer, array), length, current_index);
+    }
+
+    // Mutable access copies the array first if a snapshot shares it, and
+    // discards the value index since values may be written through it.
+    // This is paid even if the caller only reads: read through the const
+    // overloads instead (cbegin/cend, or std::as_const(list) in a range-for).
+    T *data()
+    {
+        detach();
+        value_index.invalidate();
+        return array;
+    }
+
+    // Read-only access: never copies the array or touches the value index
+    const T *data() const
+    {
+        return array;
+    }
+
+    // Same cost as data(): on a non-const list, even `for (auto &x : list)` copies
+    // a shared array and discards the value index
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + length;
+    }
+
+    // Read-only iteration, free of those costs
+    const_iterator begin() const
+    {
+        return array;
+    }
+
+    const_iterator end() const
+    {
+        return array + length;
+    }
+
+    const_iterator cbegin() const
+    {
+        return array;
+    }
+
+    const_iterator cend() const
+    {
+        return array + length;
+    }
+
+#ifdef __cpp_lib_span
+    // Read-only view of the elements, for std:: and parallel algorithms
+    span<const T> view() const
+    {
+        return span<const T>(array, length);
+    }
+#endif
+
+    // The factor by which the capacity is multiplied on growth (must be greater than 1)
+    void set_growth_factor(double factor)
+    {
+        if (factor > 1)
+            growth_factor = factor;
+    }
+
+    // Pass nullptr to stop receiving capacity changes
+    void set_capacity_callback(CapacityCallback callback)
+    {
+        on_capacity_change = callback;
+    }
+
+    // Sets when the capacity grows and shrinks, as fractions of the capacity in use.
+    // Requires 0 < shrink_load and 2 * shrink_load <= grow_load <= 1, so that a halved
+    // array is never full enough to grow right away; other values are ignored.
+    void set_load_thresholds(double grow, double shrink)
+    {
+        if (shrink > 0 && shrink * 2 <= grow && grow <= 1)
         {
-            if (array[i] == value)
-                return true;
+            grow_load = grow;
+            shrink_load = shrink;
         }
-        return false;
     }
 
-    int find(int index)
+    // The capacity never shrinks below this (must be at least 1)
+    void set_min_capacity(int n)
+    {
+        if (n < 1)
+            return;
+        min_capacity = n;
+        if (capacity < n)
+            move_to_new_array(n);
+    }
+
+    // Number of consecutive removals under shrink_load before the memory is released (0 releases at once)
+    void set_shrink_delay(int removals)
+    {
+        if (removals >= 0)
+            shrink_delay = removals;
+    }
+
+    long long get_reallocation_count()
+    {
+        return reallocation_count;
+    }
+
+    long long get_bytes_copied()
+    {
+        return bytes_copied;
+    }
+
+    // reverse, search and is_present split lists of at least threshold elements
+    // among threads threads (1 turns this off). Defaults to every hardware thread.
+    void set_parallelism(int threads, int threshold)
+    {
+        parallel_threads = max(1, threads);
+        parallel_threshold = threshold;
+    }
+
+    // Makes room for n elements without any further reallocation.
+    // The list grows once it is grow_load full, so this needs a capacity of n / grow_load.
+    void reserve(int n)
+    {
+        int needed = (int)ceil(n / grow_load);
+        if (needed > capacity)
+            move_to_new_array(needed);
+    }
+
+    // Releases the unused capacity (but keeps at least min_capacity slots)
+    void shrink_to_fit()
+    {
+        int new_capacity = max(length, min_capacity);
+        if (new_capacity < capacity)
+            move_to_new_array(new_capacity);
+    }
+
+    // Turns the hash index used by is_present, search and delete_item on or off.
+    // Ignored unless T has a std::hash and can be copied (see is_indexable).
+    void set_value_index_enabled(bool enabled)
+    {
+        value_index.set_enabled(enabled);
+    }
+
+    bool is_present(const T &value)
+    {
+        if (value_index.is_enabled())
+            return value_index.contains(value, for_each_element());
+
+        return find_first_element(value) != -1;
+    }
+
+    T find(int index)
     {
         if (!withinBoundary(index))
-            return -1; // It is assumed that the list only contains non-negative integers.
+            return missing_value();
 
         current_index = index;
         return array[index];
     }
 
-    int update(int index, int value)
+    T update(int index, T value)
     {
-        int old_element = find(index);
-        if (old_element == -1)
-            return -1; // Not a valid index
+        if (!withinBoundary(index))
+            return missing_value(); // Not a valid index
 
-        array[index] = value;
+        detach();
+        T old_element = move(array[index]);
+        array[index] = move(value);
         current_index = index;
+
+        value_index.removed(old_element, index, false);
+        value_index.added(array[index], index, false);
         return old_element;
     }
 
-    int search(int value)
+    int search(const T &value)
     {
-        for (int i = 0; i < length; i++)
+        if (value_index.is_enabled())
         {
-            if (array[i] == value)
-            {
-                current_index = i;
-                return i;
-            }
+            int index = value_index.first_position(value, length, for_each_element(), [this](const T &item)
+                                                   { return find_first_element(item); });
+            if (index != -1)
+                current_index = index;
+            return index;
         }
-        return -1;
+
+        int index = find_first_element(value);
+        if (index != -1)
+            current_index = index;
+        return index;
     }
 
-    void insert(int value)
+    void insert(T value)
     {
         increase_capacity();
+        detach();
 
-        if (current_index < length - 1)
+        // Shifts the latter elements to the right by 1, into the uninitialized slot at the end
+        if (current_index + 1 == length)
+            new (array + length) T(move(value));
+        else
         {
-            // Shifts the latter elements to the right by 1
-            for (int i = length - 1; i > current_index; i--)
-            {
-                array[i + 1] = array[i];
-            }
+            new (array + length) T(move(array[length - 1]));
+            move_backward(array + current_index + 1, array + length - 1, array + length);
+            array[current_index + 1] = move(value);
         }
+        current_index++;
+        buffer->size = ++length;
 
-        array[++current_index] = value;
-        length++;
+        value_index.added(array[current_index], current_index, current_index == length - 1);
     }
 
-    void append(int value)
+    void append(T value)
     {
         if (length == 0)
             current_index = 0;
 
         increase_capacity();
+        detach();
+
+        new (array + length) T(move(value));
+        buffer->size = ++length;
+
+        value_index.added(array[length - 1], length - 1, true);
+    }
+
+    // Appends n values, growing the array at most once
+    void append_range(const T *values, int n)
+    {
+        if (n <= 0)
+            return;
+        if (length == 0)
+            current_index = 0;
 
-        array[length++] = value;
+        reserve(length + n);
+        detach();
+        uninitialized_copy(values, values + n, array + length);
+        length += n;
+        buffer->size = length;
+
+        value_index.invalidate();
     }
 
-    int delete_cur()
+    // Inserts n values after the current element, like n calls to insert()
+    void insert_range(const T *values, int n)
     {
+        insert_at_cursor(values, n);
+    }
+
+    // Moves all the elements of other after the current element, like insert_range(), and leaves other empty
+    void splice(ArrayList &other)
+    {
+        if (&other == this || other.length == 0)
+            return;
+
         if (length == 0)
-            return -1;
+        {
+            // Takes over the array of other instead of copying it
+            swap(buffer, other.buffer);
+            swap(array, other.array);
+            swap(capacity, other.capacity);
+            length = other.length;
+            current_index = length - 1;
+            value_index.invalidate();
 
-        int deleted_elem = array[current_index];
+            other.length = 0;
+            other.current_index = -1;
+            other.value_index.cleared();
+            return;
+        }
 
-        if (current_index < length - 1)
+        if constexpr (is_copy_constructible<T>::value)
         {
-            // Shifts the latter elements to the left by 1
-            for (int i = current_index + 1; i < length; i++)
-            {
-                array[i - 1] = array[i];
-            }
+            if (other.is_shared())
+                insert_at_cursor(other.array, other.length);
+            else
+                insert_at_cursor(make_move_iterator(other.array), other.length);
         }
+        else
+            insert_at_cursor(make_move_iterator(other.array), other.length);
+        other.clear();
+    }
+
+    T delete_cur()
+    {
+        if (length == 0)
+            return missing_value();
+
+        detach();
+        T deleted_elem = move(array[current_index]);
+        value_index.removed(deleted_elem, current_index, current_index == length - 1);
+
+        // Shifts the latter elements to the left by 1
+        move(array + current_index + 1, array + length, array + current_index);
 
         length--;
+        destroy_at(array + length);
+        buffer->size = length;
         if (current_index == length)
             current_index--;
 
@@ -185,22 +660,26 @@ public:
         return deleted_elem;
     }
 
-    int trim()
+    T trim()
     {
         if (length == 0)
-            return -1;
+            return missing_value();
 
         if (current_index == length - 1)
             current_index--;
 
-        int last = array[--length];
+        detach();
+        T last = move(array[--length]);
+        destroy_at(array + length);
+        buffer->size = length;
+        value_index.removed(last, length, true);
 
         decrease_capacity();
 
         return last;
     }
 
-    bool delete_item(int value)
+    bool delete_item(const T &value)
     {
         int index = search(value);
         if (index != -1)
@@ -216,9 +695,9 @@ public:
     {
         if (withinBoundary(index1) && withinBoundary(index2))
         {
-            int temp = array[index1];
-            array[index1] = array[index2];
-            array[index2] = temp;
+            detach();
+            swap(array[index1], array[index2]);
+            value_index.moved();
         }
     }
 
@@ -234,29 +713,29 @@ public:
 
     void reverse()
     {
-        for (int i = 0; i < length / 2; i++)
-        {
-            int temp = array[i];
-            array[i] = array[length - i - 1];
-            array[length - i - 1] = temp;
-        }
+        detach();
+        if (is_parallel())
+            parallel_reverse(array, length, parallel_threads);
+        else
+            std::reverse(array, array + length);
+        value_index.moved();
     }
 
-    void print()
+    void print(ostream &out = cout)
     {
         if (length == 0)
-            cout << "[ . ]" << endl;
+            out << "[ . ]\n";
         else
         {
-            cout << "[ ";
+            out << "[ ";
             for (int i = 0; i < length; i++)
             {
-                cout << array[i];
+                out << array[i];
                 if (i == current_index)
-                    cout << "|";
-                cout << " ";
+                    out << "|";
+                out << " ";
             }
-            cout << "]" << endl;
+            out << "]\n";
         }
     }
-};
\ No newline at end of file
+};
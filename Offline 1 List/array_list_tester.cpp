@@ -0,0 +1,118 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "array_list.cpp"
+using namespace std;
+
+/*
+g++ -pthread array_list_tester.cpp
+.\a.exe <number_of_tests>
+*/
+
+// Has no std::hash, so ArrayList<Point> must compile without the value index
+struct Point
+{
+    int x, y;
+
+    bool operator==(const Point &other) const
+    {
+        return x == other.x && y == other.y;
+    }
+};
+
+ostream &operator<<(ostream &out, const Point &point)
+{
+    return out << "(" << point.x << "," << point.y << ")";
+}
+
+static_assert(!is_indexable<Point>::value, "Point has no std::hash");
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    int success_count = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+        // Turning the index on is ignored, so search falls back to the scan
+        ArrayList<Point> points;
+        points.set_value_index_enabled(true);
+        vector<Point> stl_points;
+        int n = rand() % 20 + 1;
+        for (int j = 0; j < n; ++j)
+        {
+            Point point = {rand() % 5, rand() % 5};
+            points.append(point);
+            stl_points.push_back(point);
+        }
+        Point wanted = {rand() % 5, rand() % 5};
+        int stl_index = -1;
+        for (int j = 0; j < n && stl_index == -1; ++j)
+            if (stl_points[j] == wanted)
+                stl_index = j;
+
+        int my_index = points.search(wanted);
+        cout << "Operation " << i + 1 << ": search" << wanted << " -> MyList: " << my_index << ", STL: " << stl_index;
+        if (my_index == stl_index && points.is_present(wanted) == (stl_index != -1))
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // Move-only elements: append and insert move them in, and every growth moves them to the new array
+        ArrayList<unique_ptr<int>> owners;
+        vector<int> stl_values;
+        int cursor = -1;
+        for (int val = 0; val < N * 10; ++val)
+        {
+            if (rand() % 3 == 0)
+            {
+                owners.insert(make_unique<int>(val));
+                stl_values.insert(stl_values.begin() + ++cursor, val);
+            }
+            else
+            {
+                owners.append(make_unique<int>(val));
+                stl_values.push_back(val);
+                if (cursor == -1)
+                    cursor = 0;
+            }
+        }
+        bool ok = owners.size() == (int)stl_values.size() && owners.get_reallocation_count() > 0;
+        for (int j = 0; j < (int)stl_values.size() && ok; ++j)
+            ok = *owners.cbegin()[j] == stl_values[j];
+        cout << "Move-only test: " << N * 10 << " unique_ptr elements, " << owners.get_reallocation_count()
+             << " reallocations";
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
@@ -0,0 +1,321 @@
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+/*
+Gap buffer layout of the elements (logical index -> buffer slot):
+    [ front segment | gap | back segment | tail ]
+    front: buffer[0, front_length)             -> 0 ... front_length - 1
+    back:  buffer[back_start, back_end)        -> front_length ... length - 1
+
+The gap is moved lazily to the cursor only when an element is inserted or
+deleted there, so a run of edits around the cursor costs O(1) each and a
+cursor jump costs O(distance) on the next edit. The tail keeps append and
+trim O(1) wherever the gap currently is.
+*/
+class GapBufferList
+{
+    int *buffer;
+    int capacity;
+    int front_length;
+    int back_start;
+    int back_end;
+    int length;
+    int current_index;
+
+    void init()
+    {
+        capacity = 2;
+        buffer = new int[capacity];
+        front_length = 0;
+        back_start = capacity;
+        back_end = capacity;
+        length = 0;
+        current_index = -1; // Empty list
+    }
+
+    int back_length()
+    {
+        return back_end - back_start;
+    }
+
+    int &at(int index)
+    {
+        if (index < front_length)
+            return buffer[index];
+        return buffer[back_start + index - front_length];
+    }
+
+    // An empty back segment is parked at the end so that the gap and the tail merge
+    void normalize()
+    {
+        if (back_start == back_end)
+        {
+            back_start = capacity;
+            back_end = capacity;
+        }
+    }
+
+    // Copies the elements to a new buffer of new_capacity,
+    // splitting the free slots evenly between the gap and the tail
+    void relayout(int new_capacity)
+    {
+        int *new_buffer = new int[new_capacity];
+        int back = back_length();
+        copy(buffer, buffer + front_length, new_buffer);
+
+        int new_back_start = new_capacity;
+        if (back > 0)
+            new_back_start = front_length + (new_capacity - length) / 2;
+        copy(buffer + back_start, buffer + back_end, new_buffer + new_back_start);
+
+        delete[] buffer;
+        buffer = new_buffer;
+        capacity = new_capacity;
+        back_start = new_back_start;
+        back_end = new_back_start + back;
+    }
+
+    // Moves the gap so that the front segment holds exactly the first position elements
+    void move_gap_to(int position)
+    {
+        if (position < front_length)
+        {
+            int count = front_length - position;
+            if (back_length() == 0)
+            {
+                // The parked back segment is moved right after the new gap
+                back_start = capacity - count;
+                back_end = capacity;
+            }
+            else
+                back_start -= count;
+            move_backward(buffer + position, buffer + front_length, buffer + back_start + count);
+            front_length = position;
+        }
+        else if (position > front_length)
+        {
+            int count = position - front_length;
+            move(buffer + back_start, buffer + back_start + count, buffer + front_length);
+            front_length = position;
+            back_start += count;
+            normalize();
+        }
+    }
+
+    // Doubles the capacity if fewer than 2 slots are free,
+    // so that a relayout can always leave a free slot in both the gap and the tail
+    void increase_capacity()
+    {
+        if (length + 2 > capacity)
+            relayout(capacity * 2);
+    }
+
+    // Halves the capacity if size < 25% of the capacity (but not less than 2)
+    void decrease_capacity()
+    {
+        if (capacity > 2 && length * 4 < capacity)
+            relayout(capacity / 2);
+    }
+
+    void move_current_index(int n)
+    {
+        if (length == 0)
+            return;
+
+        int new_index = current_index + n;
+        if (new_index < 0)
+            current_index = 0;
+        else if (new_index >= length)
+            current_index = length - 1;
+        else
+            current_index = new_index;
+    }
+
+    bool withinBoundary(int index)
+    {
+        return index >= 0 && index < length;
+    }
+
+public:
+    GapBufferList()
+    {
+        init();
+    }
+
+    ~GapBufferList()
+    {
+        delete[] buffer;
+    }
+
+    void clear()
+    {
+        delete[] buffer;
+        init();
+    }
+
+    int size()
+    {
+        return length;
+    }
+
+    bool is_present(int value)
+    {
+        return std::find(buffer, buffer + front_length, value) != buffer + front_length ||
+               std::find(buffer + back_start, buffer + back_end, value) != buffer + back_end;
+    }
+
+    int find(int index)
+    {
+        if (!withinBoundary(index))
+            return -1; // It is assumed that the list only contains non-negative integers.
+
+        current_index = index;
+        return at(index);
+    }
+
+    int update(int index, int value)
+    {
+        if (!withinBoundary(index))
+            return -1; // Not a valid index
+
+        int old_element = at(index);
+        at(index) = value;
+        current_index = index;
+        return old_element;
+    }
+
+    int search(int value)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            if (at(i) == value)
+            {
+                current_index = i;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void insert(int value)
+    {
+        increase_capacity();
+        move_gap_to(current_index + 1);
+        if (front_length == back_start)
+            relayout(capacity); // The free slots are all in the tail
+
+        buffer[front_length++] = value;
+        current_index++;
+        length++;
+    }
+
+    void append(int value)
+    {
+        if (length == 0)
+            current_index = 0;
+
+        increase_capacity();
+        if (back_length() == 0)
+            buffer[front_length++] = value;
+        else
+        {
+            if (back_end == capacity)
+                relayout(capacity); // The free slots are all in the gap
+            buffer[back_end++] = value;
+        }
+        length++;
+    }
+
+    int delete_cur()
+    {
+        if (length == 0)
+            return -1;
+
+        move_gap_to(current_index + 1);
+        int deleted_elem = buffer[--front_length];
+
+        length--;
+        if (current_index == length)
+            current_index--;
+
+        decrease_capacity();
+
+        return deleted_elem;
+    }
+
+    int trim()
+    {
+        if (length == 0)
+            return -1;
+
+        if (current_index == length - 1)
+            current_index--;
+
+        int last;
+        if (back_length() == 0)
+            last = buffer[--front_length];
+        else
+        {
+            last = buffer[--back_end];
+            normalize();
+        }
+        length--;
+
+        decrease_capacity();
+
+        return last;
+    }
+
+    bool delete_item(int value)
+    {
+        int index = search(value);
+        if (index != -1)
+        {
+            delete_cur();
+            return true;
+        }
+        else
+            return false;
+    }
+
+    void swap_ind(int index1, int index2)
+    {
+        if (withinBoundary(index1) && withinBoundary(index2))
+            swap(at(index1), at(index2));
+    }
+
+    void prev(int n)
+    {
+        move_current_index(-n);
+    }
+
+    void next(int n)
+    {
+        move_current_index(n);
+    }
+
+    void reverse()
+    {
+        move_gap_to(length);
+        std::reverse(buffer, buffer + length);
+    }
+
+    void print(ostream &out = cout)
+    {
+        if (length == 0)
+            out << "[ . ]\n";
+        else
+        {
+            out << "[ ";
+            for (int i = 0; i < length; i++)
+            {
+                out << at(i);
+                if (i == current_index)
+                    out << "|";
+                out << " ";
+            }
+            out << "]\n";
+        }
+    }
+};
@@ -1,6 +1,21 @@
 #include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <cmath>
+#include "../common/node_pool.h"
+#include "value_index.h"
 using namespace std;
 
+// Define LINKED_LIST_DEBUG to verify the whole chain after every modification
+#ifdef LINKED_LIST_DEBUG
+#define CHECK_CONSISTENCY() assert(is_consistent())
+#else
+#define CHECK_CONSISTENCY()
+#endif
+
 class Node
 {
 public:
@@ -15,45 +30,309 @@ public:
     }
 };
 
+// NodeAllocator is a node allocation policy from node_pool.h (NodePool or HeapAllocator)
+template <typename NodeAllocator = NodePool<Node>>
 class LinkedList
 {
+public:
+    // Bidirectional iterator over the values; decrementing end() gives the last element.
+    // An iterator stays valid until its node is deleted or the list is reversed.
+    // None of them move the cursor.
+    template <bool Const>
+    class Iterator
+    {
+        friend class Iterator<!Const>;
+
+        Node *node;
+        Node *last;    // Tail of the list, for --end()
+        bool reversed; // Orientation of the list, see LinkedList::reversed
+
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef int value_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename conditional<Const, const int *, int *>::type pointer;
+        typedef typename conditional<Const, const int &, int &>::type reference;
+
+        Iterator(Node *node = nullptr, Node *last = nullptr, bool reversed = false)
+            : node(node), last(last), reversed(reversed) {}
+
+        // Converts an iterator to a const_iterator
+        Iterator(const Iterator<false> &other) : node(other.node), last(other.last), reversed(other.reversed) {}
+
+        reference operator*() const
+        {
+            return node->value;
+        }
+
+        pointer operator->() const
+        {
+            return &node->value;
+        }
+
+        Iterator &operator++()
+        {
+            node = reversed ? node->prev : node->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator &operator--()
+        {
+            if (node == nullptr)
+                node = last;
+            else
+                node = reversed ? node->next : node->prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return node == other.node;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return node != other.node;
+        }
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+private:
+    NodeAllocator allocator;
     Node *head;
     Node *tail;
     Node *current;
+    int length;
+    int current_index;
+
+    // Optional index of every stride-th node for O(sqrt n) random access.
+    // Insertions and deletions in the middle invalidate it and the next
+    // lookup rebuilds it, so it pays off when lookups outnumber such edits.
+    bool index_enabled = false;
+    bool index_valid = false;
+    int stride;
+    vector<Node *> checkpoints;
+
+    ValueIndex<int> value_index;
+
+    // reverse() only flips this flag and swaps head and tail. While it is set, the prev
+    // pointer of a node leads to the next element and next to the previous one, so
+    // all the traversal goes through next_of() and prev_of().
+    bool reversed;
+
+    // The cursor keeps its index across reverse(), but finding its new node would take a
+    // walk. So reverse() leaves current (and current_index, its index) on the old node and
+    // sets cursor_mirrored; the cursor is then at cursor_index until resolve_cursor().
+    bool cursor_mirrored;
+    int cursor_index;
+
+    Node *&next_of(Node *node) const
+    {
+        return reversed ? node->prev : node->next;
+    }
+
+    Node *&prev_of(Node *node) const
+    {
+        return reversed ? node->next : node->prev;
+    }
+
+    // Swaps next and prev of every node so that the chain is linked in the given orientation
+    void set_orientation(bool reverse_links)
+    {
+        if (reversed == reverse_links)
+            return;
+        Node *node = head;
+        while (node != nullptr)
+        {
+            Node *following = next_of(node);
+            swap(node->next, node->prev);
+            node = following;
+        }
+        reversed = reverse_links;
+    }
 
     void init()
     {
+        reversed = false;
+        cursor_mirrored = false;
         head = nullptr;
         tail = nullptr;
         current = nullptr;
+        length = 0;
+        current_index = -1; // Empty list
+        index_valid = false;
+    }
+
+    void rebuild_index()
+    {
+        stride = max(1, (int)sqrt((double)length));
+        checkpoints.clear();
+        int i = 0;
+        for (Node *node = head; node != nullptr; node = next_of(node), i++)
+        {
+            if (i % stride == 0)
+                checkpoints.push_back(node);
+        }
+        index_valid = true;
+    }
+
+    // Creates a chain of nodes holding values, linked to each other but not to the list
+    void create_chain(const int *values, int n, Node *&first, Node *&last)
+    {
+        first = allocator.create(values[0]);
+        last = first;
+        for (int i = 1; i < n; i++)
+        {
+            Node *node = allocator.create(values[i]);
+            prev_of(node) = last;
+            next_of(last) = node;
+            last = node;
+        }
+    }
+
+    // Links the chain first ... last of count nodes after the node after (at the front if nullptr)
+    void link_chain(Node *first, Node *last, int count, Node *after)
+    {
+        Node *before = after == nullptr ? head : next_of(after);
+        prev_of(first) = after;
+        next_of(last) = before;
+        if (after == nullptr)
+            head = first;
+        else
+            next_of(after) = first;
+        if (before == nullptr)
+            tail = last;
+        else
+            prev_of(before) = last;
+
+        length += count;
+        index_valid = false;
+        value_index.invalidate();
+    }
+
+    // Calls visit(value, index) for every node, used to rebuild the value index
+    auto for_each_element()
+    {
+        return [this](auto visit)
+        {
+            int i = 0;
+            for (Node *node = head; node != nullptr; node = next_of(node), i++)
+                visit(node->value, i);
+        };
+    }
+
+    // Moves current to the node at the index of the cursor after reverse()
+    void resolve_cursor()
+    {
+        if (cursor_mirrored)
+        {
+            current = find_node(cursor_index);
+            current_index = cursor_index;
+            cursor_mirrored = false;
+        }
+    }
+
+    // Keeps the index valid when a node is added at the end
+    void index_appended(Node *node)
+    {
+        if (index_valid && (length - 1) % stride == 0)
+            checkpoints.push_back(node);
     }
 
     void delete_nodes()
     {
-        Node *node = head;
-        while (node != nullptr)
+        if constexpr (NodeAllocator::releases_in_bulk && is_trivially_destructible<Node>::value)
         {
-            Node *temp = node->next;
-            delete node;
-            node = temp;
+            // Frees whole slabs instead of walking the chain
+            allocator.release_all();
+        }
+        else
+        {
+            Node *node = head;
+            while (node != nullptr)
+            {
+                Node *temp = next_of(node);
+                allocator.destroy(node);
+                node = temp;
+            }
         }
     }
 
+    // Returns the index of the first node holding value and stores the node in found, or returns -1
+    int find_first_node(int value, Node *&found)
+    {
+        int index = 0;
+        for (Node *node = head; node != nullptr; node = next_of(node))
+        {
+            if (node->value == value)
+            {
+                found = node;
+                return index;
+            }
+            index++;
+        }
+        return -1;
+    }
+
+    // Walks to the node at index from the nearest of head, tail, current
+    // and (if the index is enabled) the closest checkpoints
     Node *find_node(int index)
     {
-        if (index < 0)
+        if (index < 0 || index >= length)
             return nullptr;
 
-        int i = 0;
-        Node *node = head;
-        while (node != nullptr)
+        Node *start = head;
+        int start_index = 0;
+        if (length - 1 - index < index - start_index)
+        {
+            start = tail;
+            start_index = length - 1;
+        }
+        if (abs(index - current_index) < abs(index - start_index))
         {
-            if (i == index)
-                return node;
-            node = node->next;
-            i++;
+            start = current;
+            start_index = current_index;
+        }
+        if (index_enabled)
+        {
+            if (!index_valid)
+                rebuild_index();
+
+            int k = index / stride;
+            if (index - k * stride < abs(index - start_index))
+            {
+                start = checkpoints[k];
+                start_index = k * stride;
+            }
+            if (k + 1 < (int)checkpoints.size() && (k + 1) * stride - index < abs(index - start_index))
+            {
+                start = checkpoints[k + 1];
+                start_index = (k + 1) * stride;
+            }
         }
-        return nullptr;
+
+        Node *node = start;
+        for (int i = start_index; i < index; i++)
+            node = next_of(node);
+        for (int i = start_index; i > index; i--)
+            node = prev_of(node);
+        return node;
     }
 
 public:
@@ -71,28 +350,102 @@ public:
     {
         delete_nodes();
         init();
+        value_index.cleared();
     }
 
     int size()
     {
-        Node *node = head;
-        int i = 0;
-        while (node != nullptr)
+        return length;
+    }
+
+    // Values may be written through these, so they discard the value index, even for a
+    // loop that only reads; cbegin/cend or std::as_const(list) keep it
+    iterator begin()
+    {
+        value_index.invalidate();
+        return iterator(head, tail, reversed);
+    }
+
+    iterator end()
+    {
+        value_index.invalidate();
+        return iterator(nullptr, tail, reversed);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(head, tail, reversed);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr, tail, reversed);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Turns the checkpoint index used by find, update and swap_ind on or off
+    void set_index_enabled(bool enabled)
+    {
+        index_enabled = enabled;
+        index_valid = false;
+        if (!enabled)
+            checkpoints = vector<Node *>();
+    }
+
+    // Turns the hash index used by is_present, search and delete_item on or off
+    void set_value_index_enabled(bool enabled)
+    {
+        value_index.set_enabled(enabled);
+    }
+
+    // Walks the chain in both directions and checks the links, head, tail, current and length
+    bool is_consistent()
+    {
+        int count = 0;
+        bool current_found = current == nullptr;
+        Node *previous = nullptr;
+        for (Node *node = head; node != nullptr; node = next_of(node))
         {
-            i++;
-            node = node->next;
+            if (prev_of(node) != previous)
+                return false;
+            if (node == current)
+                current_found = current_index == count;
+            if (index_valid && count % stride == 0 && checkpoints[count / stride] != node)
+                return false;
+            previous = node;
+            count++;
         }
-        return i;
+        if (previous != tail || count != length || !current_found)
+            return false;
+
+        count = 0;
+        for (Node *node = tail; node != nullptr; node = prev_of(node))
+            count++;
+        if (cursor_mirrored && (cursor_index < 0 || cursor_index >= length))
+            return false;
+        return count == length && (length == 0) == (current == nullptr);
     }
 
     bool is_present(int value)
     {
+        if (value_index.is_enabled())
+            return value_index.contains(value, for_each_element());
+
         Node *node = head;
         while (node != nullptr)
         {
             if (node->value == value)
                 return true;
-            node = node->next;
+            node = next_of(node);
         }
         return false;
     }
@@ -103,6 +456,8 @@ public:
         if (node != nullptr)
         {
             current = node;
+            current_index = index;
+            cursor_mirrored = false;
             return node->value;
         }
         else
@@ -118,6 +473,11 @@ public:
             node->value = value;
 
             current = node;
+            current_index = index;
+            cursor_mirrored = false;
+
+            value_index.removed(old_value, index, false);
+            value_index.added(value, index, false);
 
             return old_value;
         }
@@ -127,41 +487,51 @@ public:
 
     int search(int value)
     {
-        int index = 0;
-        Node *node = head;
-        while (node != nullptr)
+        Node *found = nullptr;
+        int index;
+        if (value_index.is_enabled())
+            index = value_index.first_position(value, length, for_each_element(), [this, &found](int item)
+                                               { return find_first_node(item, found); });
+        else
+            index = find_first_node(value, found);
+
+        if (index != -1)
         {
-            if (node->value == value)
-            {
-                current = node;
-                return index;
-            }
-            node = node->next;
-            index++;
+            // An answer from the index comes without its node
+            current = found != nullptr ? found : find_node(index);
+            current_index = index;
+            cursor_mirrored = false;
         }
-        return -1;
+        return index;
     }
 
     void insert(int value)
     {
+        resolve_cursor();
         if (current == nullptr) // Empty list
         {
-            head = new Node(value);
+            head = allocator.create(value);
             tail = head;
             current = head;
         }
         else
         {
-            Node *node = new Node(value);
-            node->next = current->next;
-            node->prev = current;
-            current->next = node;
-            if (node->next == nullptr)
+            Node *node = allocator.create(value);
+            next_of(node) = next_of(current);
+            prev_of(node) = current;
+            next_of(current) = node;
+            if (next_of(node) == nullptr)
                 tail = node;
             else
-                node->next->prev = node;
+                prev_of(next_of(node)) = node;
             current = node;
         }
+        length++;
+        current_index++;
+        index_valid = false;
+        value_index.added(value, current_index, current == tail);
+
+        CHECK_CONSISTENCY();
     }
 
     void append(int value)
@@ -170,11 +540,76 @@ public:
             insert(value);
         else
         {
-            Node *node = new Node(value);
-            node->prev = tail;
-            tail->next = node;
+            Node *node = allocator.create(value);
+            prev_of(node) = tail;
+            next_of(tail) = node;
             tail = node;
+            length++;
+            index_appended(node);
+            value_index.added(value, length - 1, true);
+
+            CHECK_CONSISTENCY();
+        }
+    }
+
+    // Appends n values, linking the new nodes to the list at once
+    void append_range(const int *values, int n)
+    {
+        if (n <= 0)
+            return;
+
+        Node *first, *last;
+        create_chain(values, n, first, last);
+        link_chain(first, last, n, tail);
+        if (current == nullptr)
+        {
+            current = head;
+            current_index = 0;
         }
+
+        CHECK_CONSISTENCY();
+    }
+
+    // Inserts n values after the current element, like n calls to insert()
+    void insert_range(const int *values, int n)
+    {
+        if (n <= 0)
+            return;
+
+        resolve_cursor();
+        Node *first, *last;
+        create_chain(values, n, first, last);
+        link_chain(first, last, n, current);
+        current = last;
+        current_index += n;
+
+        CHECK_CONSISTENCY();
+    }
+
+    // Moves all the nodes of other after the current element, like insert_range(), and leaves other empty.
+    // The nodes are relinked in O(1) and their memory is handed over with allocator.adopt().
+    void splice(LinkedList &other)
+    {
+        if (&other == this || other.length == 0)
+            return;
+
+        resolve_cursor();
+
+        // Both chains must be linked the same way round before they are joined
+        if (length == 0)
+            reversed = other.reversed;
+        else
+            other.set_orientation(reversed);
+
+        allocator.adopt(other.allocator);
+        link_chain(other.head, other.tail, other.length, current);
+        current = other.tail;
+        current_index += other.length;
+
+        other.init();
+        other.value_index.cleared();
+
+        CHECK_CONSISTENCY();
     }
 
     int delete_cur()
@@ -182,40 +617,51 @@ public:
         if (current == nullptr)
             return -1;
 
+        resolve_cursor();
         int deleted_value = current->value;
+        value_index.removed(deleted_value, current_index, current == tail);
 
         if (current != head)
-            current->prev->next = current->next;
+            next_of(prev_of(current)) = next_of(current);
         else
-            head = current->next;
+            head = next_of(current);
 
         if (current != tail)
         {
-            current->next->prev = current->prev;
-            Node *temp = current->next;
-            delete current;
+            prev_of(next_of(current)) = prev_of(current);
+            Node *temp = next_of(current);
+            allocator.destroy(current);
             current = temp;
         }
         else
         {
-            tail = current->prev;
-            delete current;
+            tail = prev_of(current);
+            allocator.destroy(current);
             current = tail;
+            current_index--;
         }
+        length--;
+        index_valid = false;
+
+        CHECK_CONSISTENCY();
 
         return deleted_value;
     }
 
     int trim()
     {
+        resolve_cursor();
         if (current == tail)
             return delete_cur();
         else
         {
             Node *old_current = current;
+            int old_index = current_index;
             current = tail;
+            current_index = length - 1;
             int deleted_value = delete_cur();
             current = old_current;
+            current_index = old_index;
             return deleted_value;
         }
     }
@@ -241,15 +687,20 @@ public:
             int temp = node1->value;
             node1->value = node2->value;
             node2->value = temp;
+            value_index.moved();
         }
     }
 
     void prev(int n)
     {
+        resolve_cursor();
         for (int i = 0; i < n; i++)
         {
-            if (current != nullptr && current->prev != nullptr)
-                current = current->prev;
+            if (current != nullptr && prev_of(current) != nullptr)
+            {
+                current = prev_of(current);
+                current_index--;
+            }
             else
                 break;
         }
@@ -257,51 +708,54 @@ public:
 
     void next(int n)
     {
+        resolve_cursor();
         for (int i = 0; i < n; i++)
         {
-            if (current != nullptr && current->next != nullptr)
-                current = current->next;
+            if (current != nullptr && next_of(current) != nullptr)
+            {
+                current = next_of(current);
+                current_index++;
+            }
             else
                 break;
         }
     }
 
+    // O(1): reinterprets the chain instead of moving any value
     void reverse()
     {
         if (head != tail) // When size is not 0 or 1
         {
-            Node *left = head;
-            Node *right = tail;
-            while (true)
-            {
-                int temp = left->value;
-                left->value = right->value;
-                right->value = temp;
-                if (left->next == right || left->next == right->prev)
-                    break;
-                left = left->next;
-                right = right->prev;
-            }
+            if (!cursor_mirrored)
+                cursor_index = current_index;
+            reversed = !reversed;
+            swap(head, tail);
+            current_index = length - 1 - current_index;
+            cursor_mirrored = current_index != cursor_index;
+            index_valid = false;
+            value_index.moved();
+
+            CHECK_CONSISTENCY();
         }
     }
 
-    void print()
+    void print(ostream &out = cout)
     {
         if (head == nullptr)
-            cout << "[ . ]" << endl;
+            out << "[ . ]\n";
         else
         {
-            Node *node = head;
-            cout << "[ ";
-            while (node != nullptr)
+            int cursor = cursor_mirrored ? cursor_index : current_index;
+            int index = 0;
+            out << "[ ";
+            for (Node *node = head; node != nullptr; node = next_of(node), index++)
             {
-                cout << node->value;
-                if (node == current)
-                    cout << "|";
-                cout << " ";
-                node = node->next;
+                out << node->value;
+                if (index == cursor)
+                    out << "|";
+                out << " ";
             }
-            cout << "]" << endl;
+            out << "]\n";
         }
     }
 
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sys/resource.h>
+#include "array_list.cpp"
+#include "linked_list.cpp"
+#include "gap_buffer_list.cpp"
+#include "unrolled_list.cpp"
+using namespace std;
+
+/*
+g++ -O2 -pthread list_benchmark.cpp
+./a.out <max_size> > results.csv
+
+Runs each of the 15 list operations on lists of 1000, 10000, ... up to max_size
+(default 100000) elements with the values 0 ... size - 1, for each access pattern:
+    front, middle, back  the cursor, the indices and the searched values are at that position
+    random               random indices and values; cursor operations first move the cursor
+                         with find(random index), which is included in their time
+Prints one CSV row per (implementation, operation, size, pattern) with the time and the
+number of heap allocations per operation, and the peak RSS of the process so far.
+*/
+
+#define MIN_BATCH_TIME_NS 20000000LL // Each measurement runs for at least this long
+
+long long allocation_count = 0;
+
+void *operator new(size_t size)
+{
+    allocation_count++;
+    void *memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+        throw bad_alloc();
+    return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+enum Pattern
+{
+    FRONT,
+    MIDDLE,
+    BACK,
+    RANDOM
+};
+
+const char *pattern_names[] = {"front", "middle", "back", "random"};
+
+const char *operation_names[] = {"", "insert", "delete_cur", "append", "size", "prev", "next", "is_present",
+                                 "clear", "delete_item", "swap_ind", "search", "find", "update", "trim", "reverse"};
+
+volatile long long sink = 0; // Keeps the results from being optimized away
+
+template <typename List>
+void fill(List &list, int size)
+{
+    list.clear();
+    for (int i = 0; i < size; i++)
+        list.append(i);
+}
+
+// Index for the pattern in a list of the given size; offset moves it inwards on repeated calls
+int position(Pattern pattern, int size, int offset, mt19937 &rng)
+{
+    switch (pattern)
+    {
+    case FRONT:
+        return offset % size;
+    case MIDDLE:
+        return (size / 2 + offset) % size;
+    case BACK:
+        return size - 1 - offset % size;
+    default:
+        return rng() % size;
+    }
+}
+
+// Places the cursor where the cursor operations of the pattern take place
+template <typename List>
+void place_cursor(List &list, Pattern pattern, int size, mt19937 &rng)
+{
+    if (pattern != RANDOM)
+        list.find(position(pattern, size, 0, rng));
+}
+
+// Runs the rep-th repetition of operation op
+template <typename List>
+void apply(List &list, int op, Pattern pattern, int size, int rep, mt19937 &rng)
+{
+    if (pattern == RANDOM && (op == 1 || op == 2 || op == 5 || op == 6))
+        list.find(rng() % list.size());
+
+    switch (op)
+    {
+    case 1:
+        list.insert(rep);
+        break;
+    case 2:
+        sink += list.delete_cur();
+        break;
+    case 3:
+        list.append(rep);
+        break;
+    case 4:
+        sink += list.size();
+        break;
+    case 5:
+        list.prev(1);
+        break;
+    case 6:
+        list.next(1);
+        break;
+    case 7:
+        sink += list.is_present(position(pattern, size, 0, rng));
+        break;
+    case 8:
+        list.clear();
+        break;
+    case 9:
+        // Values equal their original index, so these stay at the position of the pattern
+        sink += list.delete_item(pattern == BACK ? size - 1 - rep : position(pattern, size, rep, rng));
+        break;
+    case 10:
+        list.swap_ind(position(pattern, size, 0, rng), position(pattern, size, 1, rng));
+        break;
+    case 11:
+        sink += list.search(position(pattern, size, 0, rng));
+        break;
+    case 12:
+        sink += list.find(position(pattern, size, 0, rng));
+        break;
+    case 13:
+        sink += list.update(position(pattern, size, 0, rng), rep);
+        break;
+    case 14:
+        sink += list.trim();
+        break;
+    case 15:
+        list.reverse();
+        break;
+    }
+}
+
+long long peak_rss_kb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template <typename List>
+void benchmark(const char *name, int max_size)
+{
+    mt19937 rng(106);
+    for (int size = 1000; size <= max_size; size *= 10)
+    {
+        for (int op = 1; op <= 15; op++)
+        {
+            for (int p = FRONT; p <= RANDOM; p++)
+            {
+                Pattern pattern = (Pattern)p;
+                List list;
+                fill(list, size);
+                place_cursor(list, pattern, size, rng);
+
+                // Keeps the size of the list between half and double of size
+                int max_reps = 1000000;
+                if (op == 1 || op == 3)
+                    max_reps = size;
+                else if (op == 2 || op == 9 || op == 14)
+                    max_reps = size / 2;
+                else if (op == 8)
+                    max_reps = 100;
+
+                long long elapsed_ns = 0;
+                long long allocations = 0;
+                int reps = 0;
+                for (int batch = 1; elapsed_ns < MIN_BATCH_TIME_NS && reps < max_reps; batch *= 2)
+                {
+                    if (op == 8)
+                    {
+                        // Refills the list before every clear, outside of the measurement
+                        fill(list, size);
+                        batch = 1;
+                    }
+                    if (batch > max_reps - reps)
+                        batch = max_reps - reps;
+
+                    long long allocations_before = allocation_count;
+                    auto start = chrono::steady_clock::now();
+                    for (int i = 0; i < batch; i++)
+                        apply(list, op, pattern, size, reps + i, rng);
+                    auto end = chrono::steady_clock::now();
+
+                    allocations += allocation_count - allocations_before;
+                    elapsed_ns += chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+                    reps += batch;
+                }
+
+                cout << name << "," << operation_names[op] << "," << size << "," << pattern_names[pattern] << ","
+                     << (double)elapsed_ns / reps << "," << (double)allocations / reps << "," << peak_rss_kb() << endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int max_size = 100000;
+    if (argc > 1)
+    {
+        max_size = atoi(argv[1]);
+        if (max_size < 1000)
+        {
+            cerr << "Invalid maximum size. Using default value of 100000.\n";
+            max_size = 100000;
+        }
+    }
+
+    cout << "implementation,operation,size,pattern,ns_per_op,allocations_per_op,peak_rss_kb" << endl;
+    benchmark<ArrayList<int>>("ArrayList", max_size);
+    benchmark<LinkedList<>>("LinkedList", max_size);
+    benchmark<GapBufferList>("GapBufferList", max_size);
+    benchmark<UnrolledList>("UnrolledList", max_size);
+
+    return 0;
+}
@@ -1,146 +1,350 @@
 #include <iostream>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 #include "array_list.cpp"
 #include "linked_list.cpp"
+#include "gap_buffer_list.cpp"
+#include "unrolled_list.cpp"
 
 using namespace std;
 
-int main()
+/*
+g++ -O2 -pthread main.cpp
+./a.out [input_file] [--quiet | --checksum]
+
+--quiet     prints the results of the operations but not the list after each of them
+--checksum  prints only a 64-bit FNV-1a hash of the output of --quiet (without the capacity
+            changes, so that every list implementation gives the same hash), for replaying long traces
+*/
+
+#define OUTPUT_BUFFER_SIZE (1 << 20) // Bytes collected before the output is written to stdout
+
+enum Mode
 {
-    FILE *file = fopen("input.txt", "r");
-    if (file == NULL)
-        return 1;
+    VERBOSE,
+    QUIET,
+    CHECKSUM
+};
+
+Mode mode = VERBOSE;
+ostream *output = &cout;
+
+// Collects the output in a large buffer and writes it to stdout only when full (or at the end)
+class BufferedOutput : public streambuf
+{
+    vector<char> buffer;
+
+public:
+    BufferedOutput() : buffer(OUTPUT_BUFFER_SIZE)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~BufferedOutput()
+    {
+        sync();
+    }
+
+protected:
+    int overflow(int ch) override
+    {
+        sync();
+        if (ch != EOF)
+        {
+            *pptr() = (char)ch;
+            pbump(1);
+        }
+        return ch == EOF ? 0 : ch;
+    }
+
+    int sync() override
+    {
+        fwrite(pbase(), 1, pptr() - pbase(), stdout);
+        fflush(stdout);
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return 0;
+    }
+};
+
+// Hashes everything written to it with 64-bit FNV-1a instead of printing it
+class ChecksumOutput : public streambuf
+{
+    unsigned long long hash = 14695981039346656037ULL;
+
+public:
+    unsigned long long value()
+    {
+        return hash;
+    }
+
+protected:
+    int overflow(int ch) override
+    {
+        if (ch == EOF)
+            return 0;
+        hash = (hash ^ (unsigned char)ch) * 1099511628211ULL;
+        return ch;
+    }
+
+    streamsize xsputn(const char *text, streamsize count) override
+    {
+        for (streamsize i = 0; i < count; i++)
+            hash = (hash ^ (unsigned char)text[i]) * 1099511628211ULL;
+        return count;
+    }
+};
+
+// Loads the whole input file at once and parses the integers from memory
+class InputParser
+{
+    vector<char> data;
+    size_t position = 0;
+    bool failed = false; // Set by a number out of range; no more numbers are read after it
+
+public:
+    bool open(const char *path)
+    {
+        FILE *file = fopen(path, "rb");
+        if (file == NULL)
+            return false;
+
+        fseek(file, 0, SEEK_END);
+        data.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        size_t read = fread(data.data(), 1, data.size(), file);
+        data.resize(read);
+        fclose(file);
+        return true;
+    }
+
+    // Reads the next integer like cin >> value, returns false if there is none.
+    // A number out of the range of int is clamped to it and ends the input, as with cin.
+    bool next(int &value)
+    {
+        if (failed)
+            return false;
+        while (position < data.size() && isspace((unsigned char)data[position]))
+            position++;
+
+        bool negative = false;
+        if (position < data.size() && (data[position] == '-' || data[position] == '+'))
+            negative = data[position++] == '-';
+        if (position >= data.size() || !isdigit((unsigned char)data[position]))
+            return false;
+
+        // Accumulated as a magnitude that stops growing just past INT_MAX + 1, so it cannot overflow
+        const long long limit = (long long)INT_MAX + 1;
+        long long result = 0;
+        while (position < data.size() && isdigit((unsigned char)data[position]))
+        {
+            result = result * 10 + (data[position++] - '0');
+            if (result > limit)
+                result = limit + 1;
+        }
+        if (negative ? result > limit : result > INT_MAX)
+        {
+            value = negative ? INT_MIN : INT_MAX;
+            failed = true;
+            return false;
+        }
+        value = (int)(negative ? -result : result);
+        return true;
+    }
+};
+
+// Reports the capacity changes of ArrayList in the format of the sample output
+void print_capacity_change(int old_capacity, int new_capacity)
+{
+    // Capacity depends on the implementation, so it is left out of the checksum
+    if (mode == CHECKSUM)
+        return;
+    *output << "Capacity " << (new_capacity > old_capacity ? "increased" : "decreased")
+            << " from " << old_capacity << " to " << new_capacity << '\n';
+}
 
-    ArrayList list;
-    // LinkedList list;
+template <typename List>
+void print_list(List &list)
+{
+    if (mode == VERBOSE)
+        list.print(*output);
+}
+
+template <typename List>
+void run(InputParser &input, List &list)
+{
+    ostream &out = *output;
 
     int func, arg1, arg2;
-    while (fscanf(file, "%d", &func) == 1 && func != 0)
+    while (input.next(func) && func != 0)
     {
-        if (func == 1 && fscanf(file, "%d", &arg1) == 1)
+        if (func == 1 && input.next(arg1))
         {
-            cout << "Insert " << arg1 << endl;
+            out << "Insert " << arg1 << '\n';
             list.insert(arg1);
-            list.print();
+            print_list(list);
         }
         else if (func == 2)
         {
-            cout << "Delete current item" << endl;
+            out << "Delete current item\n";
             int deleted_elem = list.delete_cur();
             if (deleted_elem != -1)
             {
-                list.print();
-                cout << deleted_elem << " is deleted" << endl;
+                print_list(list);
+                out << deleted_elem << " is deleted\n";
             }
             else
-                cout << "List is empty" << endl;
+                out << "List is empty\n";
         }
-        else if (func == 3 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 3 && input.next(arg1))
         {
-            cout << "Append " << arg1 << endl;
+            out << "Append " << arg1 << '\n';
             list.append(arg1);
-            list.print();
+            print_list(list);
         }
         else if (func == 4)
         {
-            cout << "Size of the list is " << list.size() << endl;
+            out << "Size of the list is " << list.size() << '\n';
         }
-        else if (func == 5 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 5 && input.next(arg1))
         {
-            cout << "Prev " << arg1 << endl;
+            out << "Prev " << arg1 << '\n';
             list.prev(arg1);
-            list.print();
+            print_list(list);
         }
-        else if (func == 6 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 6 && input.next(arg1))
         {
-            cout << "Next " << arg1 << endl;
+            out << "Next " << arg1 << '\n';
             list.next(arg1);
-            list.print();
+            print_list(list);
         }
-        else if (func == 7 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 7 && input.next(arg1))
         {
             int is_present = list.is_present(arg1);
             if (is_present)
-                cout << arg1 << " is present" << endl;
+                out << arg1 << " is present\n";
             else
-                cout << arg1 << " is not present" << endl;
+                out << arg1 << " is not present\n";
         }
         else if (func == 8)
         {
-            cout << "Clear list" << endl;
+            out << "Clear list\n";
             list.clear();
-            list.print();
+            print_list(list);
         }
-        else if (func == 9 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 9 && input.next(arg1))
         {
-            cout << "Delete " << arg1 << endl;
+            out << "Delete " << arg1 << '\n';
             bool is_succesful = list.delete_item(arg1);
             if (is_succesful)
-                list.print();
+                print_list(list);
             else
-                cout << arg1 << " not found" << endl;
+                out << arg1 << " not found\n";
         }
-        else if (func == 10 && fscanf(file, "%d", &arg1) == 1 && fscanf(file, "%d", &arg2) == 1)
+        else if (func == 10 && input.next(arg1) && input.next(arg2))
         {
-            cout << "Swap index " << arg1 << " and " << arg2 << endl;
+            out << "Swap index " << arg1 << " and " << arg2 << '\n';
             list.swap_ind(arg1, arg2);
-            list.print();
+            print_list(list);
         }
-        else if (func == 11 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 11 && input.next(arg1))
         {
-            cout << "Search " << arg1 << endl;
+            out << "Search " << arg1 << '\n';
             int index = list.search(arg1);
             if (index >= 0)
             {
-                list.print();
-                cout << arg1 << " is found at " << index << endl;
+                print_list(list);
+                out << arg1 << " is found at " << index << '\n';
             }
             else
-                cout << arg1 << " is not found" << endl;
+                out << arg1 << " is not found\n";
         }
-        else if (func == 12 && fscanf(file, "%d", &arg1) == 1)
+        else if (func == 12 && input.next(arg1))
         {
-            cout << "Find " << arg1 << endl;
+            out << "Find " << arg1 << '\n';
             int elem = list.find(arg1);
             if (elem != -1)
             {
-                list.print();
-                cout << elem << " is found at " << arg1 << endl;
+                print_list(list);
+                out << elem << " is found at " << arg1 << '\n';
             }
             else
-                cout << arg1 << " is not a valid index" << endl;
+                out << arg1 << " is not a valid index\n";
         }
-        else if (func == 13 && fscanf(file, "%d", &arg1) == 1 && fscanf(file, "%d", &arg2) == 1)
+        else if (func == 13 && input.next(arg1) && input.next(arg2))
         {
-            cout << "Update element at " << arg1 << endl;
+            out << "Update element at " << arg1 << '\n';
             int old_elem = list.update(arg1, arg2);
             if (old_elem != -1)
             {
-                list.print();
-                cout << old_elem << " is updated by " << arg2 << endl;
+                print_list(list);
+                out << old_elem << " is updated by " << arg2 << '\n';
             }
             else
-                cout << arg1 << " is not a valid index" << endl;
+                out << arg1 << " is not a valid index\n";
         }
         else if (func == 14)
         {
-            cout << "Trim" << endl;
+            out << "Trim\n";
             int deleted_last_elem = list.trim();
             if (deleted_last_elem != -1)
             {
-                list.print();
-                cout << deleted_last_elem << " removed" << endl;
+                print_list(list);
+                out << deleted_last_elem << " removed\n";
             }
             else
-                cout << "List is empty" << endl;
+                out << "List is empty\n";
         }
         else if (func == 15)
         {
-            cout << "Reverse" << endl;
+            out << "Reverse\n";
             list.reverse();
-            list.print();
+            print_list(list);
         }
     }
-    cout << "End" << endl;
+    out << "End\n";
+}
+
+int main(int argc, char *argv[])
+{
+    const char *input_file = "input.txt";
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quiet") == 0)
+            mode = QUIET;
+        else if (strcmp(argv[i], "--checksum") == 0)
+            mode = CHECKSUM;
+        else
+            input_file = argv[i];
+    }
+
+    InputParser input;
+    if (!input.open(input_file))
+        return 1;
+
+    ArrayList<int> list;
+    list.set_capacity_callback(print_capacity_change);
+    // LinkedList<> list;
+    // GapBufferList list;
+    // UnrolledList list;
+
+    if (mode == CHECKSUM)
+    {
+        ChecksumOutput checksum;
+        ostream out(&checksum);
+        output = &out;
+        run(input, list);
+        printf("Checksum %016llx\n", checksum.value());
+    }
+    else
+    {
+        BufferedOutput buffer;
+        ostream out(&buffer);
+        output = &out;
+        run(input, list);
+    }
 
     return 0;
 }
@@ -0,0 +1,83 @@
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "simd_search.h"
+using namespace std;
+
+/**
+ * Parallel versions of the whole-array loops of ArrayList. The array is split into
+ * one contiguous chunk per thread; the calling thread handles the first chunk.
+ * Threads are started per call, so these only pay off for arrays of at least about
+ * a million elements (see PARALLEL_THRESHOLD in array_list.cpp).
+ */
+
+#define PARALLEL_SEARCH_BLOCK 65536 // Elements scanned between checks for an earlier match
+
+// Returns the index of the first occurrence of value in values[0, n), or -1
+template <typename T>
+int find_first_in(const T *values, int n, const T &value)
+{
+    if constexpr (is_same<T, int>::value)
+        return find_first(values, n, value);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (values[i] == value)
+            return i;
+    }
+    return -1;
+}
+
+// Calls chunk(begin, end) for threads consecutive ranges covering [0, n)
+template <typename Chunk>
+void run_in_chunks(int n, int threads, Chunk chunk)
+{
+    int chunk_size = (n + threads - 1) / threads;
+    vector<thread> workers;
+    for (int begin = chunk_size; begin < n; begin += chunk_size)
+        workers.emplace_back(chunk, begin, min(n, begin + chunk_size));
+    chunk(0, min(n, chunk_size));
+    for (thread &worker : workers)
+        worker.join();
+}
+
+// find_first_in with the chunks scanned in parallel. The result is the minimum of the
+// matches of all chunks; a chunk stops once a match was found before its next block.
+template <typename T>
+int parallel_find_first(const T *values, int n, const T &value, int threads)
+{
+    atomic<int> first(INT_MAX);
+    run_in_chunks(n, threads, [&](int begin, int end)
+                  {
+        for (int block = begin; block < end && block < first.load(memory_order_relaxed); block += PARALLEL_SEARCH_BLOCK)
+        {
+            int index = find_first_in(values + block, min(end - block, PARALLEL_SEARCH_BLOCK), value);
+            if (index != -1)
+            {
+                index += block;
+                int seen = first.load(memory_order_relaxed);
+                while (index < seen && !first.compare_exchange_weak(seen, index, memory_order_relaxed))
+                    ;
+                return;
+            }
+        } });
+    int index = first.load(); // The joins order this after every store
+    return index == INT_MAX ? -1 : index;
+}
+
+// Reverses values[0, n) by swapping the chunks of the first half with the mirrored second half
+template <typename T>
+void parallel_reverse(T *values, int n, int threads)
+{
+    run_in_chunks(n / 2, threads, [&](int begin, int end)
+                  { swap_ranges(values + begin, values + end, make_reverse_iterator(values + n - begin)); });
+}
+
+#endif // PARALLEL_SCAN_H
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "simd_search.h"
+using namespace std;
+
+/*
+g++ -O2 search_benchmark.cpp
+./a.out <max_number_of_elements>
+*/
+
+// Returns the throughput of kernel in millions of elements per second,
+// searching for a value that is not present so that the whole array is scanned
+double measure(FindFirstKernel kernel, const vector<int> &values)
+{
+    int n = values.size();
+    long long total = 0;
+    int repetitions = 0;
+    volatile int sink = 0;
+
+    auto start = chrono::steady_clock::now();
+    do
+    {
+        sink = sink + kernel(values.data(), n, -1);
+        total += n;
+        repetitions++;
+    } while (total < 200000000LL || repetitions < 3);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    return total / elapsed.count() / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    long long max_elements = 10000000;
+    if (argc > 1)
+    {
+        max_elements = atoll(argv[1]);
+        if (max_elements < 1000)
+        {
+            cout << "Invalid number of elements. Using default value of 10000000.\n";
+            max_elements = 10000000;
+        }
+    }
+
+    struct Candidate
+    {
+        const char *name;
+        FindFirstKernel kernel;
+        bool supported;
+    };
+    vector<Candidate> candidates = {{"scalar", find_first_scalar, true}};
+#ifdef SIMD_SEARCH_X86
+    candidates.push_back({"sse4.2", find_first_sse, (bool)__builtin_cpu_supports("sse4.2")});
+    candidates.push_back({"avx2", find_first_avx2, (bool)__builtin_cpu_supports("avx2")});
+#endif
+
+    cout << "elements";
+    for (const Candidate &candidate : candidates)
+        cout << "," << candidate.name << "_Melem_per_s";
+    cout << "\n";
+
+    for (long long n = 1000; n <= max_elements; n *= 10)
+    {
+        vector<int> values(n);
+        for (long long i = 0; i < n; i++)
+            values[i] = rand() % 1000;
+
+        cout << n;
+        for (const Candidate &candidate : candidates)
+        {
+            if (candidate.supported)
+                cout << "," << measure(candidate.kernel, values);
+            else
+                cout << ",unsupported";
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SEARCH_X86
+#endif
+
+/**
+ * Kernels that return the index of the first occurrence of value in values[0, n), or -1.
+ * find_first() picks the widest kernel the CPU supports on its first call.
+ */
+
+typedef int (*FindFirstKernel)(const int *values, int n, int value);
+
+inline int find_first_scalar(const int *values, int n, int value)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (values[i] == value)
+            return i;
+    }
+    return -1;
+}
+
+#ifdef SIMD_SEARCH_X86
+// Compares 16 ints per iteration with four 128-bit compares
+__attribute__((target("sse4.2"))) inline int find_first_sse(const int *values, int n, int value)
+{
+    const __m128i needle = _mm_set1_epi32(value);
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(values + i)), needle);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(values + i + 4)), needle);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(values + i + 8)), needle);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(values + i + 12)), needle);
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (!_mm_testz_si128(any, any))
+        {
+            // Each mask holds one bit per int of its vector
+            int masks[4] = {_mm_movemask_ps(_mm_castsi128_ps(a)), _mm_movemask_ps(_mm_castsi128_ps(b)),
+                            _mm_movemask_ps(_mm_castsi128_ps(c)), _mm_movemask_ps(_mm_castsi128_ps(d))};
+            for (int j = 0; j < 4; j++)
+            {
+                if (masks[j] != 0)
+                    return i + j * 4 + __builtin_ctz(masks[j]);
+            }
+        }
+    }
+    int rest = find_first_scalar(values + i, n - i, value);
+    return rest == -1 ? -1 : i + rest;
+}
+
+// Compares 16 ints per iteration with two 256-bit compares
+__attribute__((target("avx2"))) inline int find_first_avx2(const int *values, int n, int value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(values + i)), needle);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(values + i + 8)), needle);
+        // One bit per int: the low 8 bits come from a, the high 8 bits from b
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(a)) |
+                        ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    int rest = find_first_scalar(values + i, n - i, value);
+    return rest == -1 ? -1 : i + rest;
+}
+#endif
+
+inline FindFirstKernel select_find_first_kernel()
+{
+#ifdef SIMD_SEARCH_X86
+    if (__builtin_cpu_supports("avx2"))
+        return find_first_avx2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return find_first_sse;
+#endif
+    return find_first_scalar;
+}
+
+inline int find_first(const int *values, int n, int value)
+{
+    static const FindFirstKernel kernel = select_find_first_kernel();
+    return kernel(values, n, value);
+}
+
+#endif // SIMD_SEARCH_H
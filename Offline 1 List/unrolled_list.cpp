@@ -0,0 +1,420 @@
+#include <iostream>
+#include <algorithm>
+#include "../common/node_pool.h"
+using namespace std;
+
+#ifndef BLOCK_CAPACITY
+#define BLOCK_CAPACITY 64 // Number of values stored contiguously in one block
+#endif
+
+class Block
+{
+public:
+    int count;
+    int values[BLOCK_CAPACITY];
+    Block *next;
+    Block *prev;
+
+    Block() : count(0), next(nullptr), prev(nullptr) {}
+};
+
+/*
+Unrolled linked list: a doubly linked list of blocks, each holding up to
+BLOCK_CAPACITY values in an array. Scans run over contiguous arrays, an
+insertion only shifts values inside one block (splitting it when full),
+and a block that falls below a quarter full is merged with a neighbour.
+The cursor is kept as (block, offset) together with its index.
+*/
+class UnrolledList
+{
+    NodePool<Block, 16> allocator;
+    Block *head;
+    Block *tail;
+    Block *current_block;
+    int current_offset;
+    int current_index;
+    int length;
+
+    void init()
+    {
+        head = nullptr;
+        tail = nullptr;
+        current_block = nullptr;
+        current_offset = -1;
+        current_index = -1; // Empty list
+        length = 0;
+    }
+
+    Block *new_block_after(Block *block)
+    {
+        Block *new_block = allocator.create();
+        new_block->prev = block;
+        if (block == nullptr)
+        {
+            new_block->next = head;
+            head = new_block;
+        }
+        else
+        {
+            new_block->next = block->next;
+            block->next = new_block;
+        }
+        if (new_block->next == nullptr)
+            tail = new_block;
+        else
+            new_block->next->prev = new_block;
+        return new_block;
+    }
+
+    void unlink(Block *block)
+    {
+        if (block->prev == nullptr)
+            head = block->next;
+        else
+            block->prev->next = block->next;
+        if (block->next == nullptr)
+            tail = block->prev;
+        else
+            block->next->prev = block->prev;
+        allocator.destroy(block);
+    }
+
+    // Moves the values of right to the end of left and removes right
+    void merge(Block *left, Block *right)
+    {
+        copy(right->values, right->values + right->count, left->values + left->count);
+        if (current_block == right)
+        {
+            current_block = left;
+            current_offset += left->count;
+        }
+        left->count += right->count;
+        unlink(right);
+    }
+
+    // Removes a block that became empty, or merges one that is less than a quarter full
+    void rebalance(Block *block)
+    {
+        if (block->count == 0)
+            unlink(block);
+        else if (block->count * 4 < BLOCK_CAPACITY)
+        {
+            if (block->next != nullptr && block->count + block->next->count <= BLOCK_CAPACITY)
+                merge(block, block->next);
+            else if (block->prev != nullptr && block->prev->count + block->count <= BLOCK_CAPACITY)
+                merge(block->prev, block);
+        }
+    }
+
+    // Finds the block and the offset of the value at index (which must be valid),
+    // starting from the nearest of head, tail and the block of the cursor
+    Block *locate(int index, int &offset)
+    {
+        Block *block = head;
+        int block_start = 0;
+        if (current_block != nullptr && abs(index - current_index) < index)
+        {
+            block = current_block;
+            block_start = current_index - current_offset;
+        }
+        if (length - 1 - index < abs(index - block_start))
+        {
+            block = tail;
+            block_start = length - tail->count;
+        }
+
+        while (index < block_start)
+        {
+            block = block->prev;
+            block_start -= block->count;
+        }
+        while (index >= block_start + block->count)
+        {
+            block_start += block->count;
+            block = block->next;
+        }
+        offset = index - block_start;
+        return block;
+    }
+
+    void move_current_index(int n)
+    {
+        if (length == 0)
+            return;
+
+        int new_index = current_index + n;
+        if (new_index < 0)
+            new_index = 0;
+        else if (new_index >= length)
+            new_index = length - 1;
+
+        current_block = locate(new_index, current_offset);
+        current_index = new_index;
+    }
+
+    bool withinBoundary(int index)
+    {
+        return index >= 0 && index < length;
+    }
+
+    void delete_blocks()
+    {
+        allocator.release_all();
+    }
+
+public:
+    UnrolledList()
+    {
+        init();
+    }
+
+    ~UnrolledList()
+    {
+        delete_blocks();
+    }
+
+    void clear()
+    {
+        delete_blocks();
+        init();
+    }
+
+    int size()
+    {
+        return length;
+    }
+
+    bool is_present(int value)
+    {
+        for (Block *block = head; block != nullptr; block = block->next)
+        {
+            if (std::find(block->values, block->values + block->count, value) != block->values + block->count)
+                return true;
+        }
+        return false;
+    }
+
+    int find(int index)
+    {
+        if (!withinBoundary(index))
+            return -1; // It is assumed that the list only contains non-negative integers.
+
+        current_block = locate(index, current_offset);
+        current_index = index;
+        return current_block->values[current_offset];
+    }
+
+    int update(int index, int value)
+    {
+        if (!withinBoundary(index))
+            return -1; // Not a valid index
+
+        int old_element = find(index);
+        current_block->values[current_offset] = value;
+        return old_element;
+    }
+
+    int search(int value)
+    {
+        int block_start = 0;
+        for (Block *block = head; block != nullptr; block = block->next)
+        {
+            int *found = std::find(block->values, block->values + block->count, value);
+            if (found != block->values + block->count)
+            {
+                current_block = block;
+                current_offset = found - block->values;
+                current_index = block_start + current_offset;
+                return current_index;
+            }
+            block_start += block->count;
+        }
+        return -1;
+    }
+
+    void insert(int value)
+    {
+        Block *block = current_block;
+        int position = current_offset + 1;
+        if (block == nullptr) // Empty list
+        {
+            block = new_block_after(nullptr);
+            position = 0;
+        }
+        else if (block->count == BLOCK_CAPACITY)
+        {
+            // Splits the full block in two halves
+            Block *right = new_block_after(block);
+            int half = BLOCK_CAPACITY / 2;
+            copy(block->values + half, block->values + BLOCK_CAPACITY, right->values);
+            right->count = BLOCK_CAPACITY - half;
+            block->count = half;
+            if (position > half)
+            {
+                block = right;
+                position -= half;
+            }
+        }
+
+        move_backward(block->values + position, block->values + block->count, block->values + block->count + 1);
+        block->values[position] = value;
+        block->count++;
+
+        current_block = block;
+        current_offset = position;
+        current_index++;
+        length++;
+    }
+
+    void append(int value)
+    {
+        if (length == 0)
+        {
+            insert(value);
+            return;
+        }
+
+        Block *block = tail;
+        if (block->count == BLOCK_CAPACITY)
+            block = new_block_after(tail);
+        block->values[block->count++] = value;
+        length++;
+    }
+
+    int delete_cur()
+    {
+        if (length == 0)
+            return -1;
+
+        Block *block = current_block;
+        int offset = current_offset;
+        int deleted_elem = block->values[offset];
+        move(block->values + offset + 1, block->values + block->count, block->values + offset);
+        block->count--;
+        length--;
+
+        if (length == 0)
+        {
+            clear();
+            return deleted_elem;
+        }
+
+        // The next value takes the place of the deleted one (or the previous value if it was the last)
+        if (offset == block->count)
+        {
+            if (block->next != nullptr)
+            {
+                current_block = block->next;
+                current_offset = 0;
+            }
+            else
+            {
+                current_index--;
+                if (offset > 0)
+                    current_offset = offset - 1;
+                else
+                {
+                    current_block = block->prev;
+                    current_offset = current_block->count - 1;
+                }
+            }
+        }
+
+        rebalance(block);
+
+        return deleted_elem;
+    }
+
+    int trim()
+    {
+        if (length == 0)
+            return -1;
+
+        if (current_index == length - 1)
+            return delete_cur();
+
+        Block *block = tail;
+        int last = block->values[--block->count];
+        length--;
+
+        rebalance(block);
+
+        return last;
+    }
+
+    bool delete_item(int value)
+    {
+        int index = search(value);
+        if (index != -1)
+        {
+            delete_cur();
+            return true;
+        }
+        else
+            return false;
+    }
+
+    void swap_ind(int index1, int index2)
+    {
+        if (withinBoundary(index1) && withinBoundary(index2))
+        {
+            int offset1, offset2;
+            Block *block1 = locate(index1, offset1);
+            Block *block2 = locate(index2, offset2);
+            swap(block1->values[offset1], block2->values[offset2]);
+        }
+    }
+
+    void prev(int n)
+    {
+        move_current_index(-n);
+    }
+
+    void next(int n)
+    {
+        move_current_index(n);
+    }
+
+    void reverse()
+    {
+        if (length == 0)
+            return;
+
+        // Reverses the order of the blocks and the values inside each block
+        for (Block *block = head; block != nullptr; block = block->prev)
+        {
+            swap(block->next, block->prev);
+            std::reverse(block->values, block->values + block->count);
+        }
+        swap(head, tail);
+
+        // The cursor stays at the same index
+        current_block = head;
+        current_offset = 0;
+        int index = current_index;
+        current_index = 0;
+        current_block = locate(index, current_offset);
+        current_index = index;
+    }
+
+    void print(ostream &out = cout)
+    {
+        if (length == 0)
+            out << "[ . ]\n";
+        else
+        {
+            out << "[ ";
+            for (Block *block = head; block != nullptr; block = block->next)
+            {
+                for (int i = 0; i < block->count; i++)
+                {
+                    out << block->values[i];
+                    if (block == current_block && i == current_offset)
+                        out << "|";
+                    out << " ";
+                }
+            }
+            out << "]\n";
+        }
+    }
+};
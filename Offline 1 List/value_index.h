@@ -0,0 +1,218 @@
+#ifndef VALUE_INDEX_H
+#define VALUE_INDEX_H
+
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+using namespace std;
+
+// Filling the hash maps costs about as much as this many scans over the list
+#define VALUE_INDEX_REBUILD_COST 32
+
+// Whether the index can hold values of T: it needs std::hash<T> and copies of the values
+template <typename T, typename = void>
+struct is_indexable : false_type
+{
+};
+
+template <typename T>
+struct is_indexable<T, void_t<decltype(hash<T>()(declval<const T &>()))>> : is_copy_constructible<T>
+{
+};
+
+/**
+ * ValueIndex - Optional hash index over the values of a list
+ * Keeps the number of occurrences of every value, updated on each insertion
+ * and deletion, and the index of the first occurrence of every value.
+ * Positions are only kept up to date by appends: any other change that
+ * shifts or reorders elements marks them stale. While they are stale, lookups
+ * fall back to the list's own scan, and the positions are only rebuilt once
+ * the scans since the last such change have cost as much as a rebuild
+ * (VALUE_INDEX_REBUILD_COST passes over the list). So edits mixed with
+ * lookups cost about as much as plain scans, and a run of lookups without
+ * edits ends up answered from the map.
+ *
+ * The queries take a for_each(visit) callable that calls visit(value, index)
+ * for every element of the list in order, which is used for rebuilding.
+ *
+ * For a T it cannot hold (see is_indexable), ValueIndex is an empty class that
+ * stays disabled, so lists of such values compile and always use their scan.
+ *
+ * @tparam T - The type of the values
+ */
+template <typename T, bool Indexable = is_indexable<T>::value>
+class ValueIndex
+{
+    bool enabled = false;
+    bool counts_valid = false;
+    bool positions_valid = false;
+    long long stale_scan_cost = 0;         // Elements scanned by lookups since the positions went stale
+    unordered_map<T, int> counts;          // Value -> number of occurrences
+    unordered_map<T, int> first_positions; // Value -> index of the first occurrence
+
+    template <typename ForEach>
+    void rebuild_counts(ForEach for_each)
+    {
+        counts.clear();
+        for_each([this](const T &value, int)
+                 { counts[value]++; });
+        counts_valid = true;
+    }
+
+    template <typename ForEach>
+    void rebuild_positions(ForEach for_each)
+    {
+        // The counts are rebuilt in the same pass if needed, so lookups of absent values stay cheap
+        bool with_counts = !counts_valid;
+        first_positions.clear();
+        if (with_counts)
+            counts.clear();
+        for_each([this, with_counts](const T &value, int index)
+                 {
+                     first_positions.emplace(value, index);
+                     if (with_counts)
+                         counts[value]++; });
+        positions_valid = true;
+        counts_valid = true;
+    }
+
+    void positions_changed()
+    {
+        positions_valid = false;
+        stale_scan_cost = 0;
+    }
+
+public:
+    bool is_enabled()
+    {
+        return enabled;
+    }
+
+    void set_enabled(bool enable)
+    {
+        enabled = enable;
+        counts_valid = false;
+        positions_valid = false;
+        counts = unordered_map<T, int>();
+        first_positions = unordered_map<T, int>();
+    }
+
+    // The list became empty
+    void cleared()
+    {
+        if (!enabled)
+            return;
+        counts.clear();
+        first_positions.clear();
+        counts_valid = true;
+        positions_valid = true;
+    }
+
+    // value was inserted at index; at_end tells whether no element was shifted
+    void added(const T &value, int index, bool at_end)
+    {
+        if (!enabled)
+            return;
+        if (counts_valid)
+            counts[value]++;
+        if (!at_end)
+            positions_changed();
+        else if (positions_valid)
+            first_positions.emplace(value, index);
+    }
+
+    // value was removed from index; at_end tells whether no element was shifted
+    void removed(const T &value, int index, bool at_end)
+    {
+        if (!enabled)
+            return;
+        if (counts_valid)
+        {
+            auto it = counts.find(value);
+            if (--it->second == 0)
+                counts.erase(it);
+        }
+        if (!at_end)
+            positions_changed();
+        else if (positions_valid)
+        {
+            auto it = first_positions.find(value);
+            if (it->second == index)
+                first_positions.erase(it);
+        }
+    }
+
+    // Elements were reordered (swap, reverse) without changing the counts
+    void moved()
+    {
+        positions_changed();
+    }
+
+    // The list was changed in bulk, so everything is rebuilt on the next lookup
+    void invalidate()
+    {
+        counts_valid = false;
+        positions_changed();
+    }
+
+    template <typename ForEach>
+    bool contains(const T &value, ForEach for_each)
+    {
+        if (!counts_valid)
+            rebuild_counts(for_each);
+        return counts.find(value) != counts.end();
+    }
+
+    // Returns the index of the first occurrence of value, or -1
+    // scan(value) is the list's own search, used while the positions are stale
+    template <typename ForEach, typename Scan>
+    int first_position(const T &value, int length, ForEach for_each, Scan scan)
+    {
+        if (counts_valid && counts.find(value) == counts.end())
+            return -1;
+        if (!positions_valid)
+        {
+            if (stale_scan_cost < (long long)VALUE_INDEX_REBUILD_COST * length)
+            {
+                int index = scan(value);
+                stale_scan_cost += index == -1 ? length : index + 1;
+                return index;
+            }
+            rebuild_positions(for_each);
+        }
+        auto it = first_positions.find(value);
+        return it == first_positions.end() ? -1 : it->second;
+    }
+};
+
+// The index for values it cannot hold: never enabled, so the lists never query it
+template <typename T>
+class ValueIndex<T, false>
+{
+public:
+    bool is_enabled()
+    {
+        return false;
+    }
+
+    void set_enabled(bool) {}
+    void cleared() {}
+    void added(const T &, int, bool) {}
+    void removed(const T &, int, bool) {}
+    void moved() {}
+    void invalidate() {}
+
+    template <typename ForEach>
+    bool contains(const T &, ForEach)
+    {
+        return false;
+    }
+
+    template <typename ForEach, typename Scan>
+    int first_position(const T &value, int, ForEach, Scan scan)
+    {
+        return scan(value);
+    }
+};
+
+#endif // VALUE_INDEX_H
@@ -0,0 +1,345 @@
+#pragma once
+// Included from queue.h, after Queue and QueueInterface
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * ArrayQueue - Implementation of Queue ADT using a dynamic array
+ * Provides efficient queue operations with automatic resizing when needed
+ * The capacity is always a power of two, so positions wrap around with a mask instead of %
+ * The array is allocated uninitialized and elements are constructed in place (see emplace),
+ * so T needs no default constructor and may be move-only.
+ * @tparam T The type of the elements
+ * @tparam Virtual Whether the queue implements the virtual Queue<T> interface; StaticArrayQueue<T>
+ *                 (Virtual = false) has the same operations, resolved at compile time
+ */
+template <typename T = int, bool Virtual = true>
+class ArrayQueue : public QueueInterface<ArrayQueue<T, Virtual>, T, Virtual>
+{
+private:
+    T *data;       // Pointer to dynamically allocated array; only the slots between head and tail hold elements
+    int capacity;  // Maximum number of elements the array can currently hold
+    unsigned mask; // capacity - 1
+    unsigned head; // Number of dequeues since the last resize; head & mask is the index of the front element
+    unsigned tail; // Number of enqueues since the last resize; tail & mask is the index after the rear element
+
+public:
+    /**
+     * Constructor
+     * @param capacity Initial capacity of the queue, rounded up to a power of two (default: 2)
+     */
+    ArrayQueue(int capacity = 2);
+
+    /**
+     * Destructor - Destroys the elements and frees the array
+     */
+    ~ArrayQueue();
+
+    ArrayQueue(const ArrayQueue &) = delete;
+    ArrayQueue &operator=(const ArrayQueue &) = delete;
+
+    // Queue interface implementation (these override Queue<T> when Virtual is true)
+    void enqueue(T value);
+    bool try_dequeue(T &value);
+    void clear();
+    const T *peek_front() const;
+    const T *peek_back() const;
+    bool empty() const;
+    int size() const;
+    string toString() const;
+    void enqueue_bulk(const T *values, int n); // At most two memcpys after one resize, for trivially copyable T
+    int dequeue_bulk(T *values, int n);        // At most two memcpys before one resize, for trivially copyable T
+
+    /**
+     * Constructs an element at the back of the queue from args
+     */
+    template <typename... Args>
+    void emplace(Args &&...args);
+
+    // Additional method to get the current capacity of the queue
+    int getCapacity() const;
+
+private:
+    /**
+     * Resizes the internal array when it becomes full or too empty
+     * @param new_capacity The new capacity of the array
+     */
+    void resize(int new_capacity);
+
+    /**
+     * Grows the array by doubling until it has room for n more elements
+     */
+    void reserve_more(int n);
+
+    /**
+     * Halves the array while it is less than 25% full (but not less than 2)
+     */
+    void shrink();
+};
+
+template <typename T>
+using StaticArrayQueue = ArrayQueue<T, false>;
+
+// Constructor implementation
+template <typename T, bool Virtual>
+ArrayQueue<T, Virtual>::ArrayQueue(int initial_capacity)
+{
+    capacity = 2;
+    while (capacity < initial_capacity) {
+        capacity *= 2;
+    }
+    data = allocator<T>().allocate(capacity);
+    mask = capacity - 1;
+    head = 0;
+    tail = 0;
+}
+
+// Destructor implementation
+template <typename T, bool Virtual>
+ArrayQueue<T, Virtual>::~ArrayQueue()
+{
+    if constexpr (!is_trivially_destructible<T>::value) {
+        for (unsigned i = head; i != tail; i++) {
+            data[i & mask].~T();
+        }
+    }
+    allocator<T>().deallocate(data, capacity);
+}
+
+// Emplace implementation (construct an item at the rear of the queue)
+template <typename T, bool Virtual>
+template <typename... Args>
+void ArrayQueue<T, Virtual>::emplace(Args &&...args)
+{
+    // If full, resize the array to double its current capacity
+    if (size() == capacity)
+    {
+        // The queue is full
+        resize(capacity * 2);
+    }
+
+    new (data + (tail & mask)) T(std::forward<Args>(args)...);
+    tail++;
+}
+
+// Enqueue implementation (add an item to the rear of the queue)
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::enqueue(T item)
+{
+    emplace(std::move(item));
+}
+
+// Try dequeue implementation (remove an item from the front of the queue)
+template <typename T, bool Virtual>
+bool ArrayQueue<T, Virtual>::try_dequeue(T &value)
+{
+    if (empty()) {
+        return false;
+    }
+
+    T &element = data[head & mask];
+    value = std::move(element);
+    element.~T();
+    head++;
+
+    shrink();
+    return true;
+}
+
+// Clear implementation
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::clear()
+{
+    if constexpr (!is_trivially_destructible<T>::value) {
+        for (unsigned i = head; i != tail; i++) {
+            data[i & mask].~T();
+        }
+    }
+    head = 0;
+    tail = 0;
+    resize(2);
+}
+
+// Size implementation
+template <typename T, bool Virtual>
+int ArrayQueue<T, Virtual>::size() const
+{
+    // Unsigned subtraction stays correct when the counters wrap around
+    return (int)(tail - head);
+}
+
+// Peek front implementation
+template <typename T, bool Virtual>
+const T *ArrayQueue<T, Virtual>::peek_front() const
+{
+    if (empty()) {
+        return nullptr;
+    }
+    return data + (head & mask);
+}
+
+// Peek back implementation (the element at the back of the queue)
+template <typename T, bool Virtual>
+const T *ArrayQueue<T, Virtual>::peek_back() const
+{
+    if (empty()) {
+        return nullptr;
+    }
+    return data + ((tail - 1) & mask);
+}
+
+// Empty implementation
+template <typename T, bool Virtual>
+bool ArrayQueue<T, Virtual>::empty() const
+{
+    return tail == head;
+}
+
+// Print implementation in the format: <elem1, elem2, ..., elemN|
+template <typename T, bool Virtual>
+string ArrayQueue<T, Virtual>::toString() const
+{
+    string result = "<";
+    for (unsigned i = head; i != tail; i++)
+    {
+        result += element_to_string(data[i & mask]);
+        if (i + 1 != tail)
+        {
+            result += ", ";
+        }
+    }
+    result += "|";
+    return result;
+}
+
+// Resize implementation (moves the elements to the front of a new array)
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::resize(int new_capacity)
+{
+    T *new_array = allocator<T>().allocate(new_capacity);
+
+    int count = size();
+    for (int i = 0; i < count; i++)
+    {
+        T &element = data[(head + i) & mask];
+        new (new_array + i) T(std::move(element));
+        element.~T();
+    }
+
+    allocator<T>().deallocate(data, capacity);
+    data = new_array;
+    head = 0;
+    tail = count;
+    capacity = new_capacity;
+    mask = new_capacity - 1;
+}
+
+// Reserve more implementation
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::reserve_more(int n)
+{
+    int new_capacity = capacity;
+    while (new_capacity - size() < n)
+    {
+        new_capacity *= 2;
+    }
+    if (new_capacity != capacity) {
+        resize(new_capacity);
+    }
+}
+
+// Shrink implementation
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::shrink()
+{
+    int new_capacity = capacity;
+    while (new_capacity >= 4 && size() * 4 < new_capacity)
+    {
+        new_capacity /= 2;
+    }
+    if (new_capacity != capacity) {
+        resize(new_capacity);
+    }
+}
+
+// Bulk enqueue implementation (grows at most once, then copies around the wrap point)
+template <typename T, bool Virtual>
+void ArrayQueue<T, Virtual>::enqueue_bulk(const T *values, int n)
+{
+    if (n <= 0) {
+        return;
+    }
+
+    if constexpr (is_trivially_copyable<T>::value)
+    {
+        reserve_more(n);
+
+        // The first part fills the array up to its end, the rest starts again at index 0
+        int start = tail & mask;
+        int first_part = min(n, capacity - start);
+        memcpy(data + start, values, first_part * sizeof(T));
+        memcpy(data, values + first_part, (n - first_part) * sizeof(T));
+        tail += n;
+    }
+    else if constexpr (is_copy_constructible<T>::value)
+    {
+        reserve_more(n);
+        for (int i = 0; i < n; i++) {
+            emplace(values[i]);
+        }
+    }
+    else {
+        throw logic_error("enqueue_bulk copies the elements");
+    }
+}
+
+// Bulk dequeue implementation (copies around the wrap point, then shrinks at most once)
+template <typename T, bool Virtual>
+int ArrayQueue<T, Virtual>::dequeue_bulk(T *values, int n)
+{
+    int count = min(n, size());
+    if (count <= 0) {
+        return 0;
+    }
+
+    if constexpr (is_trivially_copyable<T>::value)
+    {
+        int start = head & mask;
+        int first_part = min(count, capacity - start);
+        memcpy(values, data + start, first_part * sizeof(T));
+        memcpy(values + first_part, data, (count - first_part) * sizeof(T));
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            T &element = data[(head + i) & mask];
+            values[i] = std::move(element);
+            element.~T();
+        }
+    }
+    head += count;
+
+    // Same rule as dequeue, applied once for the whole batch
+    shrink();
+    return count;
+}
+
+template <typename T, bool Virtual>
+int ArrayQueue<T, Virtual>::getCapacity() const
+{
+    return capacity;
+}
+
+// template <typename T, bool Virtual>
+// void ArrayQueue<T, Virtual>::debug_print() const {
+//     cout << "Capacity: " << capacity << endl;
+//     cout << "Size: " << size() << endl;
+//     cout << "Head: " << head << endl;
+//     cout << "Tail: " << tail << endl;
+//     cout << toString() << endl << endl;
+// }
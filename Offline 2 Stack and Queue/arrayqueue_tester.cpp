@@ -3,6 +3,8 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <stdexcept>
 #include "queue.h"
 using namespace std;
 
@@ -24,7 +26,7 @@ int main(int argc, char *argv[])
         }
     }
     srand((unsigned)time(0));
-    Queue *my_queue = new ArrayQueue();
+    Queue<int> *my_queue = new ArrayQueue<int>();
     queue<int> stl_queue;
 
     {
@@ -172,7 +174,7 @@ int main(int argc, char *argv[])
         cout << my_queue->toString() << endl
              << endl;
 
-        int capacity = ((ArrayQueue *)my_queue)->getCapacity();
+        int capacity = ((ArrayQueue<int> *)my_queue)->getCapacity();
         if ((my_queue->size() < capacity / 4 && capacity > 2))
         {
             cout << "\033[31m[Error]\033[0m Queue size is less than 25\% of its capacity." << endl;
@@ -188,6 +190,167 @@ int main(int argc, char *argv[])
 
     delete my_queue;
 
+    {
+        // Bulk operations start anywhere in the array, so their two copies meet at the wrap point;
+        // dequeue_bulk must shrink the array back to at least 25% full
+        ArrayQueue<int> bulk_queue;
+        queue<int> stl_reference;
+        int values[64];
+        bool ok = true;
+        for (int j = 0; j < N * 10 && ok; ++j)
+        {
+            int n = rand() % 64;
+            if (rand() % 2 == 0)
+            {
+                for (int k = 0; k < n; ++k)
+                {
+                    values[k] = rand() % 100;
+                    stl_reference.push(values[k]);
+                }
+                bulk_queue.enqueue_bulk(values, n);
+            }
+            else
+            {
+                int count = bulk_queue.dequeue_bulk(values, n);
+                ok = count == min(n, (int)stl_reference.size());
+                for (int k = 0; k < count && ok; ++k)
+                {
+                    ok = values[k] == stl_reference.front();
+                    stl_reference.pop();
+                }
+            }
+            int capacity = bulk_queue.getCapacity();
+            ok = ok && bulk_queue.size() == (int)stl_reference.size() && (capacity & (capacity - 1)) == 0 &&
+                 (capacity == 2 || bulk_queue.size() * 4 >= capacity);
+            if (!stl_reference.empty())
+                ok = ok && bulk_queue.front() == stl_reference.front() && bulk_queue.back() == stl_reference.back();
+        }
+        cout << "Bulk test: " << N * 10 << " enqueue_bulk/dequeue_bulk calls of up to 63 elements";
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // An empty queue answers according to its EmptyPolicy, and -1 is still an ordinary element
+        ArrayQueue<int> empty_queue;
+        bool ok = empty_queue.dequeue() == -1 && empty_queue.front() == -1 && !empty_queue.poll();
+        empty_queue.enqueue(-1);
+        optional<int> polled = empty_queue.poll();
+        ok = ok && polled && *polled == -1 && empty_queue.empty();
+
+        empty_queue.set_empty_policy(EmptyPolicy::Sentinel, -7);
+        ok = ok && empty_queue.dequeue() == -7 && empty_queue.back() == -7;
+
+        empty_queue.set_empty_policy(EmptyPolicy::Throw);
+        int thrown = 0;
+        try
+        {
+            empty_queue.dequeue();
+        }
+        catch (const out_of_range &)
+        {
+            thrown++;
+        }
+        try
+        {
+            empty_queue.front();
+        }
+        catch (const out_of_range &)
+        {
+            thrown++;
+        }
+        ok = ok && thrown == 2;
+        string policies = "Sentinel, custom sentinel, Throw";
+
+#ifdef NDEBUG
+        // A failed assert would end the tester, so Assert is only checked where it falls back to the sentinel
+        empty_queue.set_empty_policy(EmptyPolicy::Assert, -9);
+        ok = ok && empty_queue.dequeue() == -9;
+        policies += ", Assert";
+#endif
+        cout << "Empty policy test: " << policies;
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // Move-only elements: emplace constructs them in place, poll moves them out again
+        ArrayQueue<unique_ptr<int>> owners;
+        for (int val = 0; val < 100; ++val)
+            owners.emplace(new int(val));
+        owners.enqueue(make_unique<int>(100));
+        bool ok = owners.size() == 101 && **owners.peek_front() == 0 && **owners.peek_back() == 100;
+        for (int val = 0; val <= 100; ++val)
+        {
+            optional<unique_ptr<int>> owner = owners.poll();
+            ok = ok && owner && **owner == val;
+        }
+        ok = ok && owners.empty() && !owners.poll() && owners.getCapacity() == 2;
+        cout << "Move-only test: 101 unique_ptr elements";
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // StaticArrayQueue has the same operations, without the virtual calls
+        StaticArrayQueue<int> static_queue;
+        queue<int> stl_reference;
+        bool ok = true;
+        for (int j = 0; j < N * 10; ++j)
+        {
+            if (rand() % 3 != 0)
+            {
+                int val = rand() % 100;
+                static_queue.enqueue(val);
+                stl_reference.push(val);
+            }
+            else
+            {
+                int stl_dequeued = -1;
+                if (!stl_reference.empty())
+                {
+                    stl_dequeued = stl_reference.front();
+                    stl_reference.pop();
+                }
+                ok = ok && static_queue.dequeue() == stl_dequeued;
+            }
+            ok = ok && static_queue.size() == (int)stl_reference.size();
+            if (!stl_reference.empty())
+                ok = ok && static_queue.front() == stl_reference.front() && static_queue.back() == stl_reference.back();
+        }
+        cout << "StaticArrayQueue test: " << N * 10 << " operations, final size " << static_queue.size();
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
     if (success_count == N)
         cout << "\033[32mAll operations passed!\033[0m\n";
     else
@@ -0,0 +1,245 @@
+#include "queue.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor implementation
+BlockingQueue::BlockingQueue(int capacity)
+{
+    this->capacity = max(capacity, 1);
+    closed = false;
+    waiting_producers = 0;
+    waiting_consumers = 0;
+}
+
+// Wake implementation (one notify per thread that can make progress, instead of notify_all)
+void BlockingQueue::wake(condition_variable &condition, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        condition.notify_one();
+    }
+}
+
+// Push wait implementation
+bool BlockingQueue::push_wait(int value)
+{
+    unique_lock<mutex> guard(lock);
+    if (!closed && elements.size() == capacity)
+    {
+        waiting_producers++;
+        not_full.wait(guard, [this]() { return closed || elements.size() < capacity; });
+        waiting_producers--;
+    }
+    if (closed) {
+        return false;
+    }
+
+    elements.enqueue(value);
+    bool wake_consumer = waiting_consumers > 0;
+    guard.unlock();
+
+    if (wake_consumer) {
+        not_empty.notify_one();
+    }
+    return true;
+}
+
+// Try push implementation
+bool BlockingQueue::try_push(int value)
+{
+    unique_lock<mutex> guard(lock);
+    if (closed || elements.size() == capacity) {
+        return false;
+    }
+
+    elements.enqueue(value);
+    bool wake_consumer = waiting_consumers > 0;
+    guard.unlock();
+
+    if (wake_consumer) {
+        not_empty.notify_one();
+    }
+    return true;
+}
+
+// Pop wait implementation
+bool BlockingQueue::pop_wait(int &value)
+{
+    unique_lock<mutex> guard(lock);
+    if (!closed && elements.empty())
+    {
+        waiting_consumers++;
+        not_empty.wait(guard, [this]() { return closed || !elements.empty(); });
+        waiting_consumers--;
+    }
+    return take_front(guard, value);
+}
+
+// Try pop for implementation
+bool BlockingQueue::try_pop_for(int &value, chrono::nanoseconds timeout)
+{
+    unique_lock<mutex> guard(lock);
+    if (!closed && elements.empty() && timeout > chrono::nanoseconds::zero())
+    {
+        waiting_consumers++;
+        not_empty.wait_for(guard, timeout, [this]() { return closed || !elements.empty(); });
+        waiting_consumers--;
+    }
+    return take_front(guard, value);
+}
+
+// Try pop implementation (never waits, so it does not count as a waiting consumer either)
+bool BlockingQueue::try_pop(int &value)
+{
+    unique_lock<mutex> guard(lock);
+    return take_front(guard, value);
+}
+
+// Take front implementation
+bool BlockingQueue::take_front(unique_lock<mutex> &guard, int &value)
+{
+    if (!elements.try_dequeue(value)) {
+        // Empty (timed out, or closed and drained)
+        return false;
+    }
+
+    bool wake_producer = waiting_producers > 0;
+    guard.unlock();
+
+    if (wake_producer) {
+        not_full.notify_one();
+    }
+    return true;
+}
+
+// Close implementation
+void BlockingQueue::close()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+    }
+    not_full.notify_all();
+    not_empty.notify_all();
+}
+
+bool BlockingQueue::is_closed() const
+{
+    lock_guard<mutex> guard(lock);
+    return closed;
+}
+
+// Enqueue implementation (the value is dropped if the queue is closed)
+void BlockingQueue::enqueue(int item)
+{
+    push_wait(item);
+}
+
+// Try dequeue implementation
+bool BlockingQueue::try_dequeue(int &value)
+{
+    return try_pop(value);
+}
+
+// Bulk enqueue implementation (enqueues as many as fit under one lock, waking one consumer per element)
+void BlockingQueue::enqueue_bulk(const int *values, int n)
+{
+    int done = 0;
+    while (done < n)
+    {
+        unique_lock<mutex> guard(lock);
+        if (!closed && elements.size() == capacity)
+        {
+            waiting_producers++;
+            not_full.wait(guard, [this]() { return closed || elements.size() < capacity; });
+            waiting_producers--;
+        }
+        if (closed) {
+            // The rest of the values are dropped
+            return;
+        }
+
+        int count = min(n - done, capacity - elements.size());
+        elements.enqueue_bulk(values + done, count);
+        done += count;
+        int wake_count = min(count, waiting_consumers);
+        guard.unlock();
+
+        wake(not_empty, wake_count);
+    }
+}
+
+// Bulk dequeue implementation (takes what is there under one lock, waking one producer per element)
+int BlockingQueue::dequeue_bulk(int *values, int n)
+{
+    unique_lock<mutex> guard(lock);
+    int count = elements.dequeue_bulk(values, n);
+    int wake_count = min(count, waiting_producers);
+    guard.unlock();
+
+    wake(not_full, wake_count);
+    return count;
+}
+
+// Clear implementation (wakes every waiting producer, as the queue has room for all of them)
+void BlockingQueue::clear()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        elements.clear();
+    }
+    not_full.notify_all();
+}
+
+// Peek front implementation (copies the element while holding the lock, see the class comment)
+const int *BlockingQueue::peek_front() const
+{
+    static thread_local int copy;
+    lock_guard<mutex> guard(lock);
+    const int *element = elements.peek_front();
+    if (element == nullptr) {
+        return nullptr;
+    }
+    copy = *element;
+    return &copy;
+}
+
+// Peek back implementation
+const int *BlockingQueue::peek_back() const
+{
+    static thread_local int copy;
+    lock_guard<mutex> guard(lock);
+    const int *element = elements.peek_back();
+    if (element == nullptr) {
+        return nullptr;
+    }
+    copy = *element;
+    return &copy;
+}
+
+// Empty implementation
+bool BlockingQueue::empty() const
+{
+    lock_guard<mutex> guard(lock);
+    return elements.empty();
+}
+
+// Size implementation
+int BlockingQueue::size() const
+{
+    lock_guard<mutex> guard(lock);
+    return elements.size();
+}
+
+// Print implementation in the format: <elem1, elem2, ..., elemN|
+string BlockingQueue::toString() const
+{
+    lock_guard<mutex> guard(lock);
+    return elements.toString();
+}
+
+int BlockingQueue::getCapacity() const
+{
+    return capacity;
+}
@@ -0,0 +1,270 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include "queue.h"
+using namespace std;
+
+/*
+g++ -pthread blockingqueue_tester.cpp blockingqueue.cpp arrayqueue.cpp
+.\a.exe <number_of_tests>
+*/
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    BlockingQueue *my_queue = new BlockingQueue(64);
+    queue<int> stl_queue;
+
+    {
+        cout << "Initializing queue with random elements...\n";
+        int initial_size = rand() % 20 + 1; // Random initial size between 1 and 10
+        for (int i = 0; i < initial_size; ++i)
+        {
+            int val = rand() % 100;
+            my_queue->enqueue(val);
+            stl_queue.push(val);
+        }
+        cout << "Initial queue: " << my_queue->toString() << endl
+             << endl;
+    }
+
+    int success_count = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        int op = rand() % 6; // Random operation
+
+        switch (op)
+        {
+        case 0:
+        {
+            cout << "Operation " << i + 1 << ": clear()";
+            my_queue->clear();
+            stl_queue = queue<int>();
+            if (my_queue->empty())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+
+            {
+                cout << "Reinitializing queue with random elements...\n";
+                int initial_size = rand() % 50 + 1; // Random initial size between 1 and 20
+                for (int i = 0; i < initial_size; ++i)
+                {
+                    int val = rand() % 100;
+                    my_queue->enqueue(val);
+                    stl_queue.push(val);
+                }
+            }
+        }
+        break;
+
+        case 1:
+        {
+            int val = rand() % 100;
+            cout << "Operation " << i + 1 << ": enqueue(" << val << ")";
+            bool enqueued = my_queue->try_push(val);
+            bool full = (int)stl_queue.size() == my_queue->getCapacity();
+            if (!full)
+                stl_queue.push(val);
+
+            if (enqueued == !full && my_queue->back() == stl_queue.back())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+
+        break;
+
+        case 2:
+        {
+            int my_dequeued = my_queue->dequeue();
+
+            int stl_dequeued = -1;
+            if (!stl_queue.empty())
+            {
+                stl_dequeued = stl_queue.front();
+                stl_queue.pop();
+            }
+
+            cout << "Operation " << i + 1 << ": dequeue() -> MyQueue: " << my_dequeued << ", STL: " << stl_dequeued;
+            if (my_dequeued == stl_dequeued)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 3:
+        {
+            int my_front = my_queue->front();
+            int stl_front = -1;
+            if (!stl_queue.empty())
+            {
+                stl_front = stl_queue.front();
+            }
+            cout << "Operation " << i + 1 << ": front() -> MyQueue: " << my_front << ", STL: " << stl_front;
+            if (my_front == stl_front)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 4:
+        {
+            int my_back = my_queue->back();
+            int stl_back = -1;
+            if (!stl_queue.empty())
+            {
+                stl_back = stl_queue.back();
+            }
+            cout << "Operation " << i + 1 << ": back() -> MyQueue: " << my_back << ", STL: " << stl_back;
+            if (my_back == stl_back)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 5:
+        {
+            int my_size = my_queue->size();
+            int stl_size = stl_queue.size();
+            cout << "Operation " << i + 1 << ": size() -> MyQueue: " << my_size << ", STL: " << stl_size;
+            if (my_size == stl_size)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        default:
+            break;
+        }
+        cout << my_queue->toString() << endl
+             << endl;
+    }
+
+    delete my_queue;
+
+    {
+        // Producers block on a tiny queue until the consumers catch up; after close() the
+        // consumers drain what is left and then return, so every element arrives exactly once
+        const int PRODUCERS = 3, CONSUMERS = 3;
+        int M = N * 100; // Elements per producer
+        BlockingQueue shared_queue(4);
+        cout << "Blocking test: " << PRODUCERS << " producers x " << M << " elements, " << CONSUMERS
+             << " consumers, capacity " << shared_queue.getCapacity();
+
+        vector<thread> producers, consumers;
+        vector<long long> sums(CONSUMERS, 0);
+        vector<int> counts(CONSUMERS, 0);
+        for (int c = 0; c < CONSUMERS; ++c)
+        {
+            consumers.emplace_back([&, c]()
+                                   {
+                int val;
+                while (shared_queue.pop_wait(val))
+                {
+                    sums[c] += val;
+                    counts[c]++;
+                } });
+        }
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&]()
+                                   {
+                for (int val = 0; val < M; ++val)
+                    shared_queue.push_wait(val); });
+        }
+        for (thread &t : producers)
+            t.join();
+        shared_queue.close();
+        for (thread &t : consumers)
+            t.join();
+
+        long long total_sum = 0;
+        int total_count = 0;
+        for (int c = 0; c < CONSUMERS; ++c)
+        {
+            total_sum += sums[c];
+            total_count += counts[c];
+        }
+        bool ok = total_count == PRODUCERS * M && total_sum == (long long)PRODUCERS * M * (M - 1) / 2 &&
+                  shared_queue.empty() && !shared_queue.push_wait(0);
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // try_pop_for gives up after its timeout on an empty queue, and returns early once a value arrives
+        BlockingQueue timed_queue(4);
+        int val = -1;
+        auto start = chrono::steady_clock::now();
+        bool timed_out = !timed_queue.try_pop_for(val, chrono::milliseconds(50));
+        auto waited = chrono::steady_clock::now() - start;
+
+        thread late_producer([&]()
+                             {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            timed_queue.push_wait(42); });
+        bool received = timed_queue.try_pop_for(val, chrono::seconds(10));
+        late_producer.join();
+
+        cout << "Timed wait test: waited " << chrono::duration_cast<chrono::milliseconds>(waited).count()
+             << " ms on an empty queue, then received " << val;
+        N++;
+        if (timed_out && waited >= chrono::milliseconds(50) && received && val == 42)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+#pragma once
+// Included from queue.h, after Queue and QueueInterface
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+/**
+ * ListQueueNode - Structure representing a single element in the linked list of a ListQueue
+ */
+template <typename T>
+struct ListQueueNode
+{
+    T data;              // Value stored in this node
+    ListQueueNode *next; // Pointer to the next node in the list
+
+    /**
+     * Node constructor
+     * @param next_node Pointer to the next node
+     * @param args The arguments to construct the value from
+     */
+    template <typename... Args>
+    ListQueueNode(ListQueueNode *next_node, Args &&...args) : data(std::forward<Args>(args)...), next(next_node) {}
+};
+
+/**
+ * ListQueue - Implementation of Queue ADT using a singly linked list
+ * Nodes come from a NodePool by default, so they are recycled instead of going through malloc
+ * Elements are constructed in place inside their node (see emplace), so T may be move-only.
+ * @tparam T The type of the elements
+ * @tparam Virtual Whether the queue implements the virtual Queue<T> interface; StaticListQueue<T>
+ *                 (Virtual = false) has the same operations, resolved at compile time
+ * @tparam NodeAllocator A node allocation policy from node_pool.h (NodePool or HeapAllocator)
+ */
+template <typename T = int, bool Virtual = true, typename NodeAllocator = NodePool<ListQueueNode<T>>>
+class ListQueue : public QueueInterface<ListQueue<T, Virtual, NodeAllocator>, T, Virtual>
+{
+private:
+    typedef ListQueueNode<T> Node;
+
+    NodeAllocator allocator; // Creates the nodes and takes back those of dequeued elements
+    Node *front_node;        // Pointer to the front node of the queue
+    Node *rear_node;         // Pointer to the rear node of the queue
+    int current_size;        // Number of elements currently in the queue
+
+public:
+    /**
+     * Constructor - Creates an empty queue
+     */
+    ListQueue();
+
+    /**
+     * Destructor - Cleans up any dynamically allocated memory
+     */
+    ~ListQueue();
+
+    ListQueue(const ListQueue &) = delete;
+    ListQueue &operator=(const ListQueue &) = delete;
+
+    // Queue interface implementation (these override Queue<T> when Virtual is true)
+    void enqueue(T value);
+    bool try_dequeue(T &value);
+    void clear();
+    const T *peek_front() const;
+    const T *peek_back() const;
+    bool empty() const;
+    int size() const;
+    string toString() const;
+    void enqueue_bulk(const T *values, int n); // Links the new nodes as one chain
+    int dequeue_bulk(T *values, int n);
+
+    /**
+     * Constructs an element at the back of the queue from args
+     */
+    template <typename... Args>
+    void emplace(Args &&...args);
+
+private:
+    /**
+     * Links the chain first ... last of n nodes at the rear of the queue
+     */
+    void link_at_rear(Node *first, Node *last, int n);
+};
+
+template <typename T, typename NodeAllocator = NodePool<ListQueueNode<T>>>
+using StaticListQueue = ListQueue<T, false, NodeAllocator>;
+
+// Constructor implementation
+template <typename T, bool Virtual, typename NodeAllocator>
+ListQueue<T, Virtual, NodeAllocator>::ListQueue()
+{
+    front_node = nullptr;
+    rear_node = nullptr;
+    current_size = 0;
+}
+
+// Destructor implementation
+template <typename T, bool Virtual, typename NodeAllocator>
+ListQueue<T, Virtual, NodeAllocator>::~ListQueue()
+{
+    clear();
+}
+
+// Link at rear implementation
+template <typename T, bool Virtual, typename NodeAllocator>
+void ListQueue<T, Virtual, NodeAllocator>::link_at_rear(Node *first, Node *last, int n)
+{
+    if (rear_node == nullptr)
+    {
+        // Empty queue
+        front_node = first;
+    }
+    else {
+        rear_node->next = first;
+    }
+    rear_node = last;
+    current_size += n;
+}
+
+// Emplace implementation (construct an item at the rear of the queue)
+template <typename T, bool Virtual, typename NodeAllocator>
+template <typename... Args>
+void ListQueue<T, Virtual, NodeAllocator>::emplace(Args &&...args)
+{
+    Node *node = allocator.create(nullptr, std::forward<Args>(args)...);
+    link_at_rear(node, node, 1);
+}
+
+// Enqueue implementation (add an item at the rear of the queue)
+template <typename T, bool Virtual, typename NodeAllocator>
+void ListQueue<T, Virtual, NodeAllocator>::enqueue(T item)
+{
+    emplace(std::move(item));
+}
+
+// Try dequeue implementation (remove an item from the front of the queue)
+template <typename T, bool Virtual, typename NodeAllocator>
+bool ListQueue<T, Virtual, NodeAllocator>::try_dequeue(T &value)
+{
+    if (front_node == nullptr) {
+        return false;
+    }
+
+    value = std::move(front_node->data);
+    Node *next = front_node->next;
+
+    allocator.destroy(front_node);
+
+    front_node = next;
+    if (front_node == nullptr) {
+        rear_node = nullptr;
+    }
+    current_size--;
+
+    return true;
+}
+
+// Bulk enqueue implementation (builds the nodes as one chain and links it at the rear)
+template <typename T, bool Virtual, typename NodeAllocator>
+void ListQueue<T, Virtual, NodeAllocator>::enqueue_bulk(const T *values, int n)
+{
+    if (n <= 0) {
+        return;
+    }
+
+    if constexpr (is_copy_constructible<T>::value)
+    {
+        Node *first = allocator.create(nullptr, values[0]);
+        Node *last = first;
+        for (int i = 1; i < n; i++)
+        {
+            last->next = allocator.create(nullptr, values[i]);
+            last = last->next;
+        }
+        link_at_rear(first, last, n);
+    }
+    else {
+        throw logic_error("enqueue_bulk copies the elements");
+    }
+}
+
+// Bulk dequeue implementation (dequeuing everything releases the nodes at once)
+template <typename T, bool Virtual, typename NodeAllocator>
+int ListQueue<T, Virtual, NodeAllocator>::dequeue_bulk(T *values, int n)
+{
+    int count = min(n, current_size);
+    Node *node = front_node;
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = std::move(node->data);
+        node = node->next;
+    }
+
+    if (count == current_size) {
+        clear();
+        return count;
+    }
+
+    while (front_node != node)
+    {
+        Node *next = front_node->next;
+        allocator.destroy(front_node);
+        front_node = next;
+    }
+    current_size -= count;
+    return count;
+}
+
+// Clear implementation (delete all elements)
+template <typename T, bool Virtual, typename NodeAllocator>
+void ListQueue<T, Virtual, NodeAllocator>::clear()
+{
+    if constexpr (!NodeAllocator::releases_in_bulk || !is_trivially_destructible<T>::value)
+    {
+        // The elements need their destructors (and heap nodes their delete) before the slabs are freed
+        Node *node = front_node;
+        while (node != nullptr) {
+            Node *next = node->next;
+            allocator.destroy(node);
+            node = next;
+        }
+    }
+    allocator.release_all();
+    front_node = nullptr;
+    rear_node = nullptr;
+    current_size = 0;
+}
+
+// Size implementation (return the current number of elements)
+template <typename T, bool Virtual, typename NodeAllocator>
+int ListQueue<T, Virtual, NodeAllocator>::size() const
+{
+    return current_size;
+}
+
+// Peek front implementation (the element at the front of the queue)
+template <typename T, bool Virtual, typename NodeAllocator>
+const T *ListQueue<T, Virtual, NodeAllocator>::peek_front() const
+{
+    if (front_node == nullptr) {
+        return nullptr;
+    }
+    return &front_node->data;
+}
+
+// Peek back implementation (the element at the back of the queue)
+template <typename T, bool Virtual, typename NodeAllocator>
+const T *ListQueue<T, Virtual, NodeAllocator>::peek_back() const
+{
+    if (rear_node == nullptr) {
+        return nullptr;
+    }
+    return &rear_node->data;
+}
+
+// Empty implementation (check if the queue is empty)
+template <typename T, bool Virtual, typename NodeAllocator>
+bool ListQueue<T, Virtual, NodeAllocator>::empty() const
+{
+    return front_node == nullptr;
+}
+
+// Print implementation (print elements from front to rear) in the format <elem1, elem2, ..., elemN|
+template <typename T, bool Virtual, typename NodeAllocator>
+string ListQueue<T, Virtual, NodeAllocator>::toString() const
+{
+    string result = "<";
+    Node *node = front_node;
+    while (node != nullptr) {
+        result += element_to_string(node->data);
+        if (node != rear_node) {
+            result += ", ";
+        }
+        node = node->next;
+    }
+    result += "|";
+    return result;
+}
@@ -3,6 +3,9 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include "queue.h"
 using namespace std;
 
@@ -24,7 +27,7 @@ int main(int argc, char *argv[])
         }
     }
     srand((unsigned)time(0));
-    Queue *my_queue = new ListQueue();
+    Queue<int> *my_queue = new ListQueue<int>();
     queue<int> stl_queue;
 
     {
@@ -175,6 +178,164 @@ int main(int argc, char *argv[])
 
     delete my_queue;
 
+    {
+        // An empty queue answers according to its EmptyPolicy, and -1 is still an ordinary element
+        ListQueue<int> empty_queue;
+        bool ok = empty_queue.dequeue() == -1 && empty_queue.front() == -1 && !empty_queue.poll();
+        empty_queue.enqueue(-1);
+        optional<int> polled = empty_queue.poll();
+        ok = ok && polled && *polled == -1 && empty_queue.empty();
+
+        empty_queue.set_empty_policy(EmptyPolicy::Sentinel, -7);
+        ok = ok && empty_queue.dequeue() == -7 && empty_queue.back() == -7;
+
+        empty_queue.set_empty_policy(EmptyPolicy::Throw);
+        int thrown = 0;
+        try
+        {
+            empty_queue.dequeue();
+        }
+        catch (const out_of_range &)
+        {
+            thrown++;
+        }
+        try
+        {
+            empty_queue.front();
+        }
+        catch (const out_of_range &)
+        {
+            thrown++;
+        }
+        ok = ok && thrown == 2;
+        string policies = "Sentinel, custom sentinel, Throw";
+
+#ifdef NDEBUG
+        // A failed assert would end the tester, so Assert is only checked where it falls back to the sentinel
+        empty_queue.set_empty_policy(EmptyPolicy::Assert, -9);
+        ok = ok && empty_queue.dequeue() == -9;
+        policies += ", Assert";
+#endif
+        cout << "Empty policy test: " << policies;
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // Move-only elements: emplace constructs them in place, poll moves them out again
+        ListQueue<unique_ptr<int>> owners;
+        for (int val = 0; val < 100; ++val)
+            owners.emplace(new int(val));
+        owners.enqueue(make_unique<int>(100));
+        bool ok = owners.size() == 101 && **owners.peek_front() == 0 && **owners.peek_back() == 100;
+        for (int val = 0; val <= 100; ++val)
+        {
+            optional<unique_ptr<int>> owner = owners.poll();
+            ok = ok && owner && **owner == val;
+        }
+        ok = ok && owners.empty() && !owners.poll();
+        cout << "Move-only test: 101 unique_ptr elements";
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // StaticListQueue has the same operations, without the virtual calls
+        StaticListQueue<int> static_queue;
+        queue<int> stl_reference;
+        bool ok = true;
+        for (int j = 0; j < N * 10; ++j)
+        {
+            if (rand() % 3 != 0)
+            {
+                int val = rand() % 100;
+                static_queue.enqueue(val);
+                stl_reference.push(val);
+            }
+            else
+            {
+                int stl_dequeued = -1;
+                if (!stl_reference.empty())
+                {
+                    stl_dequeued = stl_reference.front();
+                    stl_reference.pop();
+                }
+                ok = ok && static_queue.dequeue() == stl_dequeued;
+            }
+            ok = ok && static_queue.size() == (int)stl_reference.size();
+            if (!stl_reference.empty())
+                ok = ok && static_queue.front() == stl_reference.front() && static_queue.back() == stl_reference.back();
+        }
+        cout << "StaticListQueue test: " << N * 10 << " operations, final size " << static_queue.size();
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // HeapAllocator in place of the default NodePool: every node is deleted on its own
+        StaticListQueue<string, HeapAllocator<ListQueueNode<string>>> heap_queue;
+        queue<string> stl_reference;
+        string values[8];
+        bool ok = true;
+        for (int j = 0; j < N * 10 && ok; ++j)
+        {
+            int op = rand() % 4;
+            if (op < 2)
+            {
+                string val(rand() % 30 + 1, (char)('a' + rand() % 26));
+                heap_queue.enqueue(val);
+                stl_reference.push(val);
+            }
+            else if (op == 2)
+            {
+                int count = heap_queue.dequeue_bulk(values, 8);
+                ok = count == min(8, (int)stl_reference.size());
+                for (int k = 0; k < count && ok; ++k)
+                {
+                    ok = values[k] == stl_reference.front();
+                    stl_reference.pop();
+                }
+            }
+            else if (rand() % 10 == 0)
+            {
+                heap_queue.clear();
+                stl_reference = queue<string>();
+            }
+            ok = ok && heap_queue.size() == (int)stl_reference.size();
+        }
+        cout << "HeapAllocator test: " << N * 10 << " operations, final size " << heap_queue.size();
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
     if (success_count == N)
         cout << "\033[32mAll operations passed!\033[0m\n";
     else
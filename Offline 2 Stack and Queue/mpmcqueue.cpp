@@ -0,0 +1,209 @@
+#include "queue.h"
+#include <thread>
+
+using namespace std;
+
+// Constructor implementation
+MpmcQueue::MpmcQueue(int capacity)
+{
+    size_t rounded = 2;
+    while (rounded < (size_t)capacity)
+    {
+        rounded *= 2;
+    }
+    cells = new Cell[rounded];
+    for (size_t i = 0; i < rounded; i++)
+    {
+        // Every slot starts out waiting for the producer of its first round
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+    mask = rounded - 1;
+    enqueue_pos.store(0, memory_order_relaxed);
+    dequeue_pos.store(0, memory_order_relaxed);
+}
+
+// Destructor implementation
+MpmcQueue::~MpmcQueue()
+{
+    delete[] cells;
+}
+
+// Try enqueue implementation
+bool MpmcQueue::try_enqueue(int value)
+{
+    Cell *cell;
+    size_t pos = enqueue_pos.load(memory_order_relaxed);
+    while (true)
+    {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        long long diff = (long long)(sequence - pos);
+        if (diff == 0)
+        {
+            // The slot is free for this round: try to claim the position
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The slot still holds the element of the previous round
+            return false;
+        }
+        else {
+            // Another producer claimed pos first
+            pos = enqueue_pos.load(memory_order_relaxed);
+        }
+    }
+
+    // Release, so a peek that reads the new value also sees that the slot changed hands
+    cell->data.store(value, memory_order_release);
+    cell->sequence.store(pos + 1, memory_order_release); // Publishes the slot to the consumers
+    return true;
+}
+
+// Try dequeue implementation
+bool MpmcQueue::try_dequeue(int &value)
+{
+    Cell *cell;
+    size_t pos = dequeue_pos.load(memory_order_relaxed);
+    while (true)
+    {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        long long diff = (long long)(sequence - (pos + 1));
+        if (diff == 0)
+        {
+            // The slot holds the element of pos: try to claim it
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The slot has not been filled yet
+            return false;
+        }
+        else {
+            // Another consumer claimed pos first
+            pos = dequeue_pos.load(memory_order_relaxed);
+        }
+    }
+
+    value = cell->data.load(memory_order_relaxed);
+    cell->sequence.store(pos + mask + 1, memory_order_release); // Hands the slot to the next round
+    return true;
+}
+
+// Enqueue implementation (waits for the consumers while the queue is full)
+void MpmcQueue::enqueue(int item)
+{
+    while (!try_enqueue(item))
+    {
+        this_thread::yield();
+    }
+}
+
+// Clear implementation (dequeues until the queue is found empty)
+void MpmcQueue::clear()
+{
+    int value;
+    while (try_dequeue(value))
+    {
+    }
+}
+
+// Size implementation
+int MpmcQueue::size() const
+{
+    // dequeue_pos is read first, so that enqueue_pos is never behind it
+    size_t dequeued = dequeue_pos.load(memory_order_acquire);
+    size_t enqueued = enqueue_pos.load(memory_order_acquire);
+    return (int)(enqueued - dequeued);
+}
+
+// Peek front implementation
+// Another thread may dequeue the cell at any time, so the element is copied and the copy is only
+// kept if the sequence of the cell did not change while it was read (see the class comment)
+const int *MpmcQueue::peek_front() const
+{
+    static thread_local int copy;
+    while (true)
+    {
+        size_t pos = dequeue_pos.load(memory_order_acquire);
+        const Cell &cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(memory_order_acquire);
+        if (sequence == pos + 1)
+        {
+            copy = cell.data.load(memory_order_acquire);
+            if (cell.sequence.load(memory_order_relaxed) == pos + 1) {
+                return &copy;
+            }
+        }
+        else if ((long long)(sequence - (pos + 1)) < 0) {
+            // Empty, or the front element is still being written (try_dequeue would fail too)
+            return nullptr;
+        }
+        // Otherwise another consumer took the element after pos was read: look again
+    }
+}
+
+// Peek back implementation
+// Producers that claimed a position but have not written it yet are skipped, so this returns the
+// newest element that is fully enqueued
+const int *MpmcQueue::peek_back() const
+{
+    static thread_local int copy;
+    while (true)
+    {
+        size_t end = enqueue_pos.load(memory_order_acquire);
+        size_t begin = dequeue_pos.load(memory_order_acquire);
+        bool changed = false;
+        for (size_t pos = end; (long long)(pos - begin) > 0 && !changed; pos--)
+        {
+            const Cell &cell = cells[(pos - 1) & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            if (sequence == pos - 1) {
+                continue; // Claimed by a producer that is still writing it
+            }
+            if (sequence == pos)
+            {
+                copy = cell.data.load(memory_order_acquire);
+                if (cell.sequence.load(memory_order_relaxed) == pos) {
+                    return &copy;
+                }
+            }
+            changed = true; // Dequeued after end and begin were read: look again
+        }
+        if (!changed) {
+            return nullptr;
+        }
+    }
+}
+
+// Empty implementation
+bool MpmcQueue::empty() const
+{
+    return size() <= 0;
+}
+
+// Print implementation in the format: <elem1, elem2, ..., elemN|
+string MpmcQueue::toString() const
+{
+    size_t begin = dequeue_pos.load(memory_order_acquire);
+    size_t end = enqueue_pos.load(memory_order_acquire);
+    string result = "<";
+    for (size_t i = begin; i != end; i++)
+    {
+        result += to_string(cells[i & mask].data.load(memory_order_relaxed));
+        if (i + 1 != end)
+        {
+            result += ", ";
+        }
+    }
+    result += "|";
+    return result;
+}
+
+int MpmcQueue::getCapacity() const
+{
+    return (int)(mask + 1);
+}
@@ -0,0 +1,317 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <atomic>
+#include <thread>
+#include "queue.h"
+using namespace std;
+
+/*
+g++ -pthread mpmcqueue_tester.cpp mpmcqueue.cpp
+.\a.exe <number_of_tests>
+*/
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    MpmcQueue *my_queue = new MpmcQueue(64);
+    queue<int> stl_queue;
+
+    {
+        cout << "Initializing queue with random elements...\n";
+        int initial_size = rand() % 20 + 1; // Random initial size between 1 and 10
+        for (int i = 0; i < initial_size; ++i)
+        {
+            int val = rand() % 100;
+            my_queue->enqueue(val);
+            stl_queue.push(val);
+        }
+        cout << "Initial queue: " << my_queue->toString() << endl
+             << endl;
+    }
+
+    int success_count = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        int op = rand() % 6; // Random operation
+
+        switch (op)
+        {
+        case 0:
+        {
+            cout << "Operation " << i + 1 << ": clear()";
+            my_queue->clear();
+            stl_queue = queue<int>();
+            if (my_queue->empty())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+
+            {
+                cout << "Reinitializing queue with random elements...\n";
+                int initial_size = rand() % 50 + 1; // Random initial size between 1 and 20
+                for (int i = 0; i < initial_size; ++i)
+                {
+                    int val = rand() % 100;
+                    my_queue->enqueue(val);
+                    stl_queue.push(val);
+                }
+            }
+        }
+        break;
+
+        case 1:
+        {
+            int val = rand() % 100;
+            cout << "Operation " << i + 1 << ": enqueue(" << val << ")";
+            bool enqueued = my_queue->try_enqueue(val);
+            bool full = (int)stl_queue.size() == my_queue->getCapacity();
+            if (!full)
+                stl_queue.push(val);
+
+            if (enqueued == !full && my_queue->back() == stl_queue.back())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+
+        break;
+
+        case 2:
+        {
+            int my_dequeued = my_queue->dequeue();
+
+            int stl_dequeued = -1;
+            if (!stl_queue.empty())
+            {
+                stl_dequeued = stl_queue.front();
+                stl_queue.pop();
+            }
+
+            cout << "Operation " << i + 1 << ": dequeue() -> MyQueue: " << my_dequeued << ", STL: " << stl_dequeued;
+            if (my_dequeued == stl_dequeued)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 3:
+        {
+            int my_front = my_queue->front();
+            int stl_front = -1;
+            if (!stl_queue.empty())
+            {
+                stl_front = stl_queue.front();
+            }
+            cout << "Operation " << i + 1 << ": front() -> MyQueue: " << my_front << ", STL: " << stl_front;
+            if (my_front == stl_front)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 4:
+        {
+            int my_back = my_queue->back();
+            int stl_back = -1;
+            if (!stl_queue.empty())
+            {
+                stl_back = stl_queue.back();
+            }
+            cout << "Operation " << i + 1 << ": back() -> MyQueue: " << my_back << ", STL: " << stl_back;
+            if (my_back == stl_back)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 5:
+        {
+            int my_size = my_queue->size();
+            int stl_size = stl_queue.size();
+            cout << "Operation " << i + 1 << ": size() -> MyQueue: " << my_size << ", STL: " << stl_size;
+            if (my_size == stl_size)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        default:
+            break;
+        }
+        cout << my_queue->toString() << endl
+             << endl;
+    }
+
+    delete my_queue;
+
+    {
+        // Several producer and consumer threads share a small queue. Every element encodes its
+        // producer and a per-producer sequence number; each consumer must see the elements of a
+        // producer in increasing order, and every element must be dequeued exactly once. Consumers
+        // also peek at both ends while the others dequeue, and may only see enqueued elements.
+        const int PRODUCERS = 4, CONSUMERS = 4;
+        int M = N * 100; // Elements per producer
+        MpmcQueue shared_queue(16);
+        cout << "Stress test: " << PRODUCERS << " producers x " << M << " elements, " << CONSUMERS
+             << " consumers, capacity " << shared_queue.getCapacity();
+
+        vector<thread> threads;
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            threads.emplace_back([&, p]()
+                                 {
+                for (int seq = 0; seq < M; ++seq)
+                    shared_queue.enqueue(seq * PRODUCERS + p); });
+        }
+
+        vector<vector<int>> seen_count(CONSUMERS, vector<int>(PRODUCERS, 0));
+        vector<int> order_errors(CONSUMERS, 0);
+        vector<int> peek_errors(CONSUMERS, 0);
+        vector<long long> sums(CONSUMERS, 0);
+        atomic<int> remaining(PRODUCERS * M);
+        for (int c = 0; c < CONSUMERS; ++c)
+        {
+            threads.emplace_back([&, c]()
+                                 {
+                vector<int> last_seq(PRODUCERS, -1);
+                int val;
+                while (remaining.load() > 0)
+                {
+                    if ((shared_queue.try_front(val) && (val < 0 || val >= PRODUCERS * M)) ||
+                        (shared_queue.try_back(val) && (val < 0 || val >= PRODUCERS * M)))
+                        peek_errors[c]++;
+                    if (!shared_queue.try_dequeue(val))
+                    {
+                        this_thread::yield();
+                        continue;
+                    }
+                    remaining--;
+                    int p = val % PRODUCERS, seq = val / PRODUCERS;
+                    if (seq <= last_seq[p])
+                        order_errors[c]++;
+                    last_seq[p] = seq;
+                    seen_count[c][p]++;
+                    sums[c] += seq;
+                } });
+        }
+        for (thread &t : threads)
+            t.join();
+
+        bool ok = shared_queue.empty();
+        long long total = 0;
+        for (int c = 0; c < CONSUMERS; ++c)
+        {
+            ok = ok && order_errors[c] == 0 && peek_errors[c] == 0;
+            total += sums[c];
+        }
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            int count = 0;
+            for (int c = 0; c < CONSUMERS; ++c)
+                count += seen_count[c][p];
+            ok = ok && count == M;
+        }
+        ok = ok && total == (long long)PRODUCERS * M * (M - 1) / 2;
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // Producers enqueue while another thread peeks at the back. Nothing is dequeued, so once the
+        // first element is in, back must always find one, even while later positions are still
+        // being written, and it may only return enqueued elements.
+        const int PRODUCERS = 4;
+        int M = N * 100; // Elements per producer
+        MpmcQueue shared_queue(PRODUCERS * M);
+        cout << "Peek test: " << PRODUCERS << " producers x " << M << " elements, back() while they enqueue";
+
+        atomic<bool> started(false), done(false);
+        vector<thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&, p]()
+                                   {
+                for (int seq = 0; seq < M; ++seq)
+                {
+                    shared_queue.enqueue(seq * PRODUCERS + p);
+                    started = true;
+                } });
+        }
+
+        int peeks = 0, misses = 0, bad_values = 0;
+        while (!started.load())
+            this_thread::yield();
+        thread peeker([&]()
+                      {
+            int val;
+            while (!done.load())
+            {
+                peeks++;
+                if (!shared_queue.try_back(val))
+                    misses++;
+                else if (val < 0 || val >= PRODUCERS * M)
+                    bad_values++;
+            } });
+        for (thread &t : producers)
+            t.join();
+        done = true;
+        peeker.join();
+
+        N++;
+        if (misses == 0 && bad_values == 0 && shared_queue.size() == PRODUCERS * M)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m (" << misses << " of " << peeks << " peeks found no element)\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
\ No newline at end of file
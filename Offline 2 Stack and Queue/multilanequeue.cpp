@@ -0,0 +1,7 @@
+#include "queue.h"
+
+using namespace std;
+
+// MultiLaneQueue is defined in multilanequeue.hpp; the int queues are compiled once here
+template class MultiLaneQueue<int>;
+template class MultiLaneQueue<int, false>;
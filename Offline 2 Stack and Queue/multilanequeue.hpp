@@ -0,0 +1,435 @@
+#pragma once
+// Included from queue.h, after ArrayQueue
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * LanePolicy - Which lane MultiLaneQueue dequeues from next
+ */
+enum class LanePolicy
+{
+    StrictPriority,    // Always the lowest-numbered non-empty lane (lane 0 is the most urgent)
+    WeightedRoundRobin // Up to weight elements from each lane in turn, skipping empty lanes
+};
+
+/**
+ * LaneStats - Counters of one lane of a MultiLaneQueue
+ * The wait of an element is the time from its enqueue to its dequeue; elements removed by clear
+ * are not counted as dequeued.
+ */
+struct LaneStats
+{
+    long long enqueued = 0;                    // Elements enqueued into the lane
+    long long dequeued = 0;                    // Elements dequeued from the lane
+    int max_depth = 0;                         // Largest number of elements the lane has held
+    chrono::nanoseconds total_wait{0};         // Sum of the waits of the dequeued elements
+    chrono::nanoseconds max_wait{0};           // Longest wait of a dequeued element
+
+    chrono::nanoseconds average_wait() const
+    {
+        if (dequeued == 0)
+            return chrono::nanoseconds(0);
+        return chrono::nanoseconds(total_wait.count() / dequeued);
+    }
+};
+
+/**
+ * MultiLaneQueue - Queue made of several FIFO lanes, so urgent elements do not wait behind a
+ * backlog of ordinary ones
+ * Every lane is an ArrayQueue. enqueue(value, lane) picks the lane (enqueue(value) uses the last,
+ * least urgent one); dequeue takes the front element of the lane chosen by the LanePolicy, so
+ * the order is FIFO within a lane but not across lanes. Under StrictPriority a busy urgent lane
+ * starves the others; WeightedRoundRobin bounds how many elements each lane takes in a row.
+ * Every lane counts its traffic and how long its elements waited (see LaneStats).
+ * @tparam T The type of the elements, which must be default constructible
+ * @tparam Virtual Whether the queue implements the virtual Queue<T> interface (see ArrayQueue)
+ */
+template <typename T = int, bool Virtual = true>
+class MultiLaneQueue : public QueueInterface<MultiLaneQueue<T, Virtual>, T, Virtual>
+{
+private:
+    typedef chrono::steady_clock Clock;
+
+    /**
+     * Entry - An element and the time it was enqueued
+     */
+    struct Entry
+    {
+        T value;
+        Clock::time_point enqueued_at;
+
+        // Lets ArrayQueue::toString print the elements
+        friend ostream &operator<<(ostream &out, const Entry &entry)
+        {
+            return out << element_to_string(entry.value);
+        }
+    };
+
+    /**
+     * Lane - One FIFO lane and its scheduling state
+     */
+    struct Lane
+    {
+        StaticArrayQueue<Entry> entries;
+        int weight = 1; // Elements taken in a row under WeightedRoundRobin
+        LaneStats stats;
+    };
+
+    unique_ptr<Lane[]> lanes;
+    int lane_count;
+    int current_size; // Elements in all lanes
+    LanePolicy policy;
+    int turn;         // Lane whose turn it is under WeightedRoundRobin
+    int taken;        // Elements the lane of turn has taken in this turn
+
+    /**
+     * Returns the lane the next dequeue takes from (the queue must not be empty)
+     * @param used Receives the elements that lane has taken in its turn so far (WeightedRoundRobin only)
+     */
+    int next_lane(int &used) const;
+
+    // Takes the front entry of the lane chosen by the policy and uses up its turn
+    Lane &take_next(Entry &entry);
+
+    // Records the dequeue of an element enqueued at enqueued_at from lane
+    void record_dequeue(Lane &lane, Clock::time_point enqueued_at, Clock::time_point now);
+
+    void check_lane(int lane) const;
+
+public:
+    /**
+     * Constructor
+     * @param lanes Number of lanes, lane 0 being the most urgent (default: 2)
+     * @param policy How dequeue chooses between the lanes (default: StrictPriority)
+     */
+    MultiLaneQueue(int lanes = 2, LanePolicy policy = LanePolicy::StrictPriority);
+
+    MultiLaneQueue(const MultiLaneQueue &) = delete;
+    MultiLaneQueue &operator=(const MultiLaneQueue &) = delete;
+
+    // Queue interface implementation (these override Queue<T> when Virtual is true)
+    // enqueue(value) uses the last lane; peek_back is the back of the last non-empty lane
+    void enqueue(T value);
+    bool try_dequeue(T &value);
+    void clear();
+    const T *peek_front() const;
+    const T *peek_back() const;
+    bool empty() const;
+    int size() const;
+    string toString() const; // The lanes in order, such as <1, 2|<|<3|
+    void enqueue_bulk(const T *values, int n);
+    int dequeue_bulk(T *values, int n);
+
+    /**
+     * Enqueues value at the back of the given lane
+     * Throws out_of_range if there is no such lane
+     */
+    void enqueue(T value, int lane);
+
+    /**
+     * Constructs an element at the back of the given lane from args
+     */
+    template <typename... Args>
+    void emplace_into(int lane, Args &&...args);
+
+    /**
+     * Sets how dequeue chooses between the lanes; a new round of WeightedRoundRobin starts at lane 0
+     */
+    void set_policy(LanePolicy policy);
+
+    /**
+     * Sets how many elements the lane takes in a row under WeightedRoundRobin (default: 1)
+     * Throws out_of_range if there is no such lane, and invalid_argument if weight is not positive
+     */
+    void set_weight(int lane, int weight);
+
+    LanePolicy getPolicy() const;
+
+    int getLaneCount() const;
+
+    /**
+     * Returns the number of elements in the lane (its current depth)
+     */
+    int lane_size(int lane) const;
+
+    /**
+     * Returns the counters of the lane
+     */
+    const LaneStats &lane_stats(int lane) const;
+
+    /**
+     * Resets the counters of every lane (max_depth starts again from the current depth)
+     */
+    void reset_stats();
+};
+
+template <typename T>
+using StaticMultiLaneQueue = MultiLaneQueue<T, false>;
+
+// Constructor implementation
+template <typename T, bool Virtual>
+MultiLaneQueue<T, Virtual>::MultiLaneQueue(int lanes, LanePolicy policy)
+{
+    lane_count = max(lanes, 1);
+    this->lanes.reset(new Lane[lane_count]);
+    current_size = 0;
+    this->policy = policy;
+    turn = 0;
+    taken = 0;
+}
+
+// Check lane implementation
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::check_lane(int lane) const
+{
+    if (lane < 0 || lane >= lane_count) {
+        throw out_of_range("No such lane");
+    }
+}
+
+// Emplace into implementation (construct an item at the rear of a lane)
+template <typename T, bool Virtual>
+template <typename... Args>
+void MultiLaneQueue<T, Virtual>::emplace_into(int lane, Args &&...args)
+{
+    check_lane(lane);
+    Lane &target = lanes[lane];
+    target.entries.emplace(Entry{T(std::forward<Args>(args)...), Clock::now()});
+    current_size++;
+
+    target.stats.enqueued++;
+    target.stats.max_depth = max(target.stats.max_depth, target.entries.size());
+}
+
+// Enqueue implementation (add an item at the rear of a lane)
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::enqueue(T value, int lane)
+{
+    emplace_into(lane, std::move(value));
+}
+
+// Enqueue implementation (add an item at the rear of the least urgent lane)
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::enqueue(T value)
+{
+    emplace_into(lane_count - 1, std::move(value));
+}
+
+// Next lane implementation
+template <typename T, bool Virtual>
+int MultiLaneQueue<T, Virtual>::next_lane(int &used) const
+{
+    if (policy == LanePolicy::StrictPriority)
+    {
+        int lane = 0;
+        while (lanes[lane].entries.empty()) {
+            lane++;
+        }
+        return lane;
+    }
+
+    // Weighted round robin: a lane keeps its turn while it has elements and has taken less than its weight
+    int lane = turn;
+    used = taken;
+    while (lanes[lane].entries.empty() || used >= lanes[lane].weight)
+    {
+        lane = (lane + 1) % lane_count;
+        used = 0;
+    }
+    return lane;
+}
+
+// Take next implementation
+template <typename T, bool Virtual>
+typename MultiLaneQueue<T, Virtual>::Lane &MultiLaneQueue<T, Virtual>::take_next(Entry &entry)
+{
+    int used = 0;
+    int lane = next_lane(used);
+    if (policy == LanePolicy::WeightedRoundRobin)
+    {
+        turn = lane;
+        taken = used + 1;
+    }
+    lanes[lane].entries.try_dequeue(entry);
+    current_size--;
+    return lanes[lane];
+}
+
+// Record dequeue implementation
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::record_dequeue(Lane &lane, Clock::time_point enqueued_at, Clock::time_point now)
+{
+    chrono::nanoseconds wait = now - enqueued_at;
+    lane.stats.dequeued++;
+    lane.stats.total_wait += wait;
+    lane.stats.max_wait = max(lane.stats.max_wait, wait);
+}
+
+// Try dequeue implementation (remove the front item of the lane chosen by the policy)
+template <typename T, bool Virtual>
+bool MultiLaneQueue<T, Virtual>::try_dequeue(T &value)
+{
+    if (current_size == 0) {
+        return false;
+    }
+
+    Entry entry;
+    Lane &lane = take_next(entry);
+    value = std::move(entry.value);
+    record_dequeue(lane, entry.enqueued_at, Clock::now());
+    return true;
+}
+
+// Bulk enqueue implementation (copies into the least urgent lane)
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::enqueue_bulk(const T *values, int n)
+{
+    if constexpr (is_copy_constructible<T>::value)
+    {
+        for (int i = 0; i < n; i++) {
+            emplace_into(lane_count - 1, values[i]);
+        }
+    }
+    else if (n > 0) {
+        throw logic_error("enqueue_bulk copies the elements");
+    }
+}
+
+// Bulk dequeue implementation (reads the clock once for the whole batch)
+template <typename T, bool Virtual>
+int MultiLaneQueue<T, Virtual>::dequeue_bulk(T *values, int n)
+{
+    int count = min(n, current_size);
+    Clock::time_point now = Clock::now();
+    Entry entry;
+    for (int i = 0; i < count; i++)
+    {
+        Lane &lane = take_next(entry);
+        values[i] = std::move(entry.value);
+        record_dequeue(lane, entry.enqueued_at, now);
+    }
+    return count;
+}
+
+// Clear implementation (empties every lane, keeping the counters)
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::clear()
+{
+    for (int i = 0; i < lane_count; i++) {
+        lanes[i].entries.clear();
+    }
+    current_size = 0;
+}
+
+// Peek front implementation (the element the next dequeue returns)
+template <typename T, bool Virtual>
+const T *MultiLaneQueue<T, Virtual>::peek_front() const
+{
+    if (current_size == 0) {
+        return nullptr;
+    }
+    int used = 0;
+    int lane = next_lane(used);
+    return &lanes[lane].entries.peek_front()->value;
+}
+
+// Peek back implementation (the back of the last non-empty lane)
+template <typename T, bool Virtual>
+const T *MultiLaneQueue<T, Virtual>::peek_back() const
+{
+    for (int lane = lane_count - 1; lane >= 0; lane--)
+    {
+        if (!lanes[lane].entries.empty()) {
+            return &lanes[lane].entries.peek_back()->value;
+        }
+    }
+    return nullptr;
+}
+
+// Empty implementation
+template <typename T, bool Virtual>
+bool MultiLaneQueue<T, Virtual>::empty() const
+{
+    return current_size == 0;
+}
+
+// Size implementation (the elements of all lanes)
+template <typename T, bool Virtual>
+int MultiLaneQueue<T, Virtual>::size() const
+{
+    return current_size;
+}
+
+// Print implementation (every lane in the format <elem1, elem2, ..., elemN|)
+template <typename T, bool Virtual>
+string MultiLaneQueue<T, Virtual>::toString() const
+{
+    string result;
+    for (int i = 0; i < lane_count; i++) {
+        result += lanes[i].entries.toString();
+    }
+    return result;
+}
+
+// Set policy implementation
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::set_policy(LanePolicy policy)
+{
+    this->policy = policy;
+    turn = 0;
+    taken = 0;
+}
+
+// Set weight implementation
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::set_weight(int lane, int weight)
+{
+    check_lane(lane);
+    if (weight <= 0) {
+        throw invalid_argument("Lane weight must be positive");
+    }
+    lanes[lane].weight = weight;
+}
+
+template <typename T, bool Virtual>
+LanePolicy MultiLaneQueue<T, Virtual>::getPolicy() const
+{
+    return policy;
+}
+
+template <typename T, bool Virtual>
+int MultiLaneQueue<T, Virtual>::getLaneCount() const
+{
+    return lane_count;
+}
+
+// Lane size implementation
+template <typename T, bool Virtual>
+int MultiLaneQueue<T, Virtual>::lane_size(int lane) const
+{
+    check_lane(lane);
+    return lanes[lane].entries.size();
+}
+
+// Lane stats implementation
+template <typename T, bool Virtual>
+const LaneStats &MultiLaneQueue<T, Virtual>::lane_stats(int lane) const
+{
+    check_lane(lane);
+    return lanes[lane].stats;
+}
+
+// Reset stats implementation
+template <typename T, bool Virtual>
+void MultiLaneQueue<T, Virtual>::reset_stats()
+{
+    for (int i = 0; i < lane_count; i++)
+    {
+        lanes[i].stats = LaneStats();
+        lanes[i].stats.max_depth = lanes[i].entries.size();
+    }
+}
@@ -0,0 +1,309 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <chrono>
+#include <thread>
+#include "queue.h"
+using namespace std;
+
+/*
+g++ multilanequeue_tester.cpp multilanequeue.cpp
+.\a.exe <number_of_tests>
+*/
+
+const int LANES = 3;
+
+// Reference model: one STL queue per lane, and the same lane choice as MultiLaneQueue
+struct LaneModel
+{
+    vector<queue<int>> lanes = vector<queue<int>>(LANES);
+    vector<int> weights = vector<int>(LANES, 1);
+    LanePolicy policy = LanePolicy::StrictPriority;
+    int turn = 0, taken = 0;
+
+    int size() const
+    {
+        int total = 0;
+        for (const queue<int> &lane : lanes)
+            total += lane.size();
+        return total;
+    }
+
+    // The lane the next dequeue takes from, or -1 if every lane is empty
+    int next_lane(bool advance)
+    {
+        if (size() == 0)
+            return -1;
+        if (policy == LanePolicy::StrictPriority)
+        {
+            int lane = 0;
+            while (lanes[lane].empty())
+                lane++;
+            return lane;
+        }
+        int lane = turn, used = taken;
+        while (lanes[lane].empty() || used >= weights[lane])
+        {
+            lane = (lane + 1) % LANES;
+            used = 0;
+        }
+        if (advance)
+        {
+            turn = lane;
+            taken = used + 1;
+        }
+        return lane;
+    }
+
+    int dequeue()
+    {
+        int lane = next_lane(true);
+        if (lane < 0)
+            return -1;
+        int val = lanes[lane].front();
+        lanes[lane].pop();
+        return val;
+    }
+
+    int front()
+    {
+        int lane = next_lane(false);
+        return lane < 0 ? -1 : lanes[lane].front();
+    }
+
+    int back() const
+    {
+        for (int lane = LANES - 1; lane >= 0; lane--)
+            if (!lanes[lane].empty())
+                return lanes[lane].back();
+        return -1;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    MultiLaneQueue<int> *my_queue = new MultiLaneQueue<int>(LANES);
+    LaneModel model;
+
+    {
+        cout << "Initializing queue with random elements...\n";
+        int initial_size = rand() % 20 + 1;
+        for (int i = 0; i < initial_size; ++i)
+        {
+            int val = rand() % 100, lane = rand() % LANES;
+            my_queue->enqueue(val, lane);
+            model.lanes[lane].push(val);
+        }
+        cout << "Initial queue: " << my_queue->toString() << endl
+             << endl;
+    }
+
+    int success_count = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        int op = rand() % 8; // Random operation
+
+        switch (op)
+        {
+        case 0:
+        {
+            if (rand() % 4 == 0)
+            {
+                cout << "Operation " << i + 1 << ": clear()";
+                my_queue->clear();
+                model.lanes.assign(LANES, queue<int>());
+            }
+            else
+            {
+                // Switching the policy starts a new round, as in MultiLaneQueue
+                LanePolicy policy = rand() % 2 ? LanePolicy::StrictPriority : LanePolicy::WeightedRoundRobin;
+                int lane = rand() % LANES, weight = rand() % 4 + 1;
+                cout << "Operation " << i + 1 << ": set_weight(" << lane << ", " << weight << "), set_policy("
+                     << (policy == LanePolicy::StrictPriority ? "StrictPriority" : "WeightedRoundRobin") << ")";
+                my_queue->set_weight(lane, weight);
+                my_queue->set_policy(policy);
+                model.weights[lane] = weight;
+                model.policy = policy;
+                model.turn = 0;
+                model.taken = 0;
+            }
+            if (my_queue->size() == model.size())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 1:
+        case 2:
+        {
+            int val = rand() % 100, lane = rand() % (LANES + 1);
+            if (lane == LANES)
+            {
+                cout << "Operation " << i + 1 << ": enqueue(" << val << ")";
+                my_queue->enqueue(val);
+                lane = LANES - 1;
+            }
+            else
+            {
+                cout << "Operation " << i + 1 << ": enqueue(" << val << ", " << lane << ")";
+                my_queue->enqueue(val, lane);
+            }
+            model.lanes[lane].push(val);
+            if (my_queue->lane_size(lane) == (int)model.lanes[lane].size())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 3:
+        case 4:
+        {
+            int my_dequeued = my_queue->dequeue();
+            int model_dequeued = model.dequeue();
+            cout << "Operation " << i + 1 << ": dequeue() -> MyQueue: " << my_dequeued << ", Model: " << model_dequeued;
+            if (my_dequeued == model_dequeued)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 5:
+        {
+            int my_front = my_queue->front();
+            int model_front = model.front();
+            cout << "Operation " << i + 1 << ": front() -> MyQueue: " << my_front << ", Model: " << model_front;
+            if (my_front == model_front)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 6:
+        {
+            int my_back = my_queue->back();
+            int model_back = model.back();
+            cout << "Operation " << i + 1 << ": back() -> MyQueue: " << my_back << ", Model: " << model_back;
+            if (my_back == model_back)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 7:
+        {
+            int my_size = my_queue->size();
+            int model_size = model.size();
+            cout << "Operation " << i + 1 << ": size() -> MyQueue: " << my_size << ", Model: " << model_size;
+            if (my_size == model_size)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        default:
+            break;
+        }
+        cout << my_queue->toString() << endl
+             << endl;
+    }
+
+    delete my_queue;
+
+    {
+        // An urgent element overtakes a backlog of ordinary ones, and the counters of each lane
+        // record what went through it
+        MultiLaneQueue<int> lanes(2);
+        for (int val = 0; val < 1000; ++val)
+            lanes.enqueue(val, 1);
+        this_thread::sleep_for(chrono::milliseconds(2));
+        lanes.enqueue(-5, 0);
+        int first = lanes.dequeue();
+        int rest[1000];
+        int count = lanes.dequeue_bulk(rest, 1000);
+
+        const LaneStats &urgent = lanes.lane_stats(0), &bulk = lanes.lane_stats(1);
+        bool ok = first == -5 && count == 1000 && rest[0] == 0 && rest[999] == 999 && lanes.empty() &&
+                  urgent.enqueued == 1 && urgent.dequeued == 1 && urgent.max_depth == 1 &&
+                  bulk.enqueued == 1000 && bulk.dequeued == 1000 && bulk.max_depth == 1000 &&
+                  bulk.max_wait >= chrono::milliseconds(2) && urgent.max_wait < bulk.max_wait &&
+                  bulk.average_wait() <= bulk.max_wait;
+        cout << "Lane test: urgent waited " << urgent.max_wait.count() << " ns, backlog up to "
+             << bulk.max_wait.count() << " ns";
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // With both lanes backlogged, weights 3 and 1 take three urgent elements per ordinary one
+        StaticMultiLaneQueue<int> lanes(2, LanePolicy::WeightedRoundRobin);
+        lanes.set_weight(0, 3);
+        for (int val = 0; val < 8; ++val)
+        {
+            lanes.enqueue(val, 0);
+            lanes.enqueue(100 + val, 1);
+        }
+        string order;
+        for (int j = 0; j < 8; ++j)
+            order += lanes.dequeue() < 100 ? '0' : '1';
+        cout << "Weighted round robin test: lanes " << order;
+
+        N++;
+        if (order == "00010001")
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
@@ -1,25 +1,210 @@
 #pragma once
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include "../common/node_pool.h"
 using namespace std;
 
+/**
+ * EmptyPolicy - What dequeue, front and back do when the queue is empty
+ */
+enum class EmptyPolicy
+{
+    Sentinel, // Return the sentinel value (-1 for numbers and T() otherwise, unless set otherwise)
+    Throw,    // Throw out_of_range
+    Assert    // Fail an assert (and return the sentinel when asserts are disabled)
+};
+
+template <typename T, typename = void>
+struct is_printable : false_type
+{
+};
+
+template <typename T>
+struct is_printable<T, void_t<decltype(declval<ostream &>() << declval<const T &>())>> : true_type
+{
+};
+
+// Text of an element for toString: to_string for numbers, operator<< if T has one, "?" otherwise
+template <typename T>
+string element_to_string(const T &value)
+{
+    if constexpr (is_arithmetic<T>::value)
+        return to_string(value);
+    else if constexpr (is_printable<T>::value)
+    {
+        ostringstream out;
+        out << value;
+        return out.str();
+    }
+    else
+        return "?";
+}
+
+/**
+ * QueueOperations - The operations every queue builds on its try_dequeue, peek_front and peek_back
+ * Derived is the class that provides those (Curiously Recurring Template Pattern): Queue<T>, whose
+ * versions are virtual, or a queue used without the Queue<T> interface, whose calls are resolved
+ * at compile time (see ArrayQueue and ListQueue).
+ * dequeue and poll need T to be default constructible; front, back, try_front, try_back and the
+ * Sentinel policy need it to be copyable. None of them is compiled unless it is used.
+ */
+template <typename Derived, typename T>
+class QueueOperations
+{
+public:
+    /**
+     * Removes and returns the element at the front of the queue
+     * @return The element at the front of the queue (see EmptyPolicy if it is empty)
+     */
+    T dequeue()
+    {
+        T value;
+        if (self().try_dequeue(value))
+            return value;
+        return empty_result();
+    }
+
+    /**
+     * Removes and returns the element at the front of the queue, if there is one
+     * @return The element at the front of the queue, or nullopt if it is empty
+     */
+    optional<T> poll()
+    {
+        T value;
+        if (self().try_dequeue(value))
+            return optional<T>(std::move(value));
+        return nullopt;
+    }
+
+    /**
+     * Copies the element at the front of the queue into value unless the queue is empty
+     * @return true if the queue is not empty
+     */
+    bool try_front(T &value) const
+    {
+        const T *element = self().peek_front();
+        if (element == nullptr)
+            return false;
+        value = *element;
+        return true;
+    }
+
+    /**
+     * Copies the element at the back of the queue into value unless the queue is empty
+     * @return true if the queue is not empty
+     */
+    bool try_back(T &value) const
+    {
+        const T *element = self().peek_back();
+        if (element == nullptr)
+            return false;
+        value = *element;
+        return true;
+    }
+
+    /**
+     * Returns the element at the front of the queue without removing it
+     * @return The element at the front of the queue (see EmptyPolicy if it is empty)
+     */
+    T front() const
+    {
+        const T *element = self().peek_front();
+        if (element == nullptr)
+            return empty_result();
+        return *element;
+    }
+
+    /**
+     * Returns the element at the back of the queue without removing it
+     * @return The element at the back of the queue (see EmptyPolicy if it is empty)
+     */
+    T back() const
+    {
+        const T *element = self().peek_back();
+        if (element == nullptr)
+            return empty_result();
+        return *element;
+    }
+
+    /**
+     * Sets what dequeue, front and back do when the queue is empty
+     * @param policy The new policy (default: Sentinel)
+     * @param sentinel The value returned under the Sentinel policy (default: -1 for numbers, T() otherwise)
+     */
+    void set_empty_policy(EmptyPolicy policy, T sentinel = default_sentinel())
+    {
+        empty_policy = policy;
+        empty_value = std::move(sentinel);
+    }
+
+private:
+    EmptyPolicy empty_policy = EmptyPolicy::Sentinel;
+    T empty_value = default_sentinel();
+
+    static T default_sentinel()
+    {
+        if constexpr (is_arithmetic<T>::value)
+            return T(-1);
+        else
+            return T();
+    }
+
+    Derived &self()
+    {
+        return static_cast<Derived &>(*this);
+    }
+
+    const Derived &self() const
+    {
+        return static_cast<const Derived &>(*this);
+    }
+
+    // Result of dequeue, front and back on an empty queue
+    T empty_result() const
+    {
+        if (empty_policy == EmptyPolicy::Throw)
+            throw out_of_range("Queue is empty");
+        if (empty_policy == EmptyPolicy::Assert)
+            assert(!"Queue is empty");
+        return empty_value;
+    }
+};
+
 /**
  * Queue - Abstract Data Type (ADT) that follows the First-In-First-Out (FIFO) principle
  * This interface defines the operations that any queue implementation must support
+ * Implementations provide try_dequeue, peek_front and peek_back, which report an empty queue
+ * through their return value; dequeue, front and back (from QueueOperations) are built on them
+ * and handle an empty queue according to the EmptyPolicy, so no operation writes to the console.
+ * @tparam T The type of the elements, which may be move-only (such as unique_ptr)
  */
-class Queue
+template <typename T = int>
+class Queue : public QueueOperations<Queue<T>, T>
 {
 public:
+    typedef T value_type;
+
     /**
      * Enqueues an element at the back of the queue
-     * @param value The element to enqueue
+     * @param value The element to enqueue (moved into the queue)
      */
-    virtual void enqueue(int value) = 0;
+    virtual void enqueue(T value) = 0;
 
     /**
-     * Removes and returns the element at the front of the queue
-     * @return The element at the front of the queue
+     * Removes the element at the front of the queue unless the queue is empty
+     * @param value Receives the element (moved out of the queue)
+     * @return true if an element was dequeued
      */
-    virtual int dequeue() = 0;
+    virtual bool try_dequeue(T &value) = 0;
 
     /**
      * Clears all elements from the queue
@@ -27,16 +212,16 @@ public:
     virtual void clear() = 0;
 
     /**
-     * Returns the element at the front of the queue without removing it
-     * @return The element at the front of the queue
+     * Returns the element at the front of the queue without removing or copying it
+     * @return A pointer to the element, valid until it is dequeued, or nullptr if the queue is empty
      */
-    virtual int front() const = 0;
+    virtual const T *peek_front() const = 0;
 
     /**
-     * Returns the element at the back of the queue without removing it
-     * @return The element at the back of the queue
+     * Returns the element at the back of the queue without removing or copying it
+     * @return A pointer to the element, valid until the queue is next modified, or nullptr if the queue is empty
      */
-    virtual int back() const = 0;
+    virtual const T *peek_back() const = 0;
 
     /**
      * Checks if the queue is empty
@@ -55,6 +240,39 @@ public:
      */
     virtual string toString() const = 0;
 
+    /**
+     * Enqueues copies of n elements at the back of the queue, values[0] first
+     * The default implementation calls enqueue for each element
+     * Throws logic_error if T cannot be copied
+     * @param values The elements to enqueue
+     * @param n The number of elements
+     */
+    virtual void enqueue_bulk(const T *values, int n)
+    {
+        if constexpr (is_copy_constructible<T>::value)
+        {
+            for (int i = 0; i < n; i++)
+                enqueue(values[i]);
+        }
+        else if (n > 0)
+            throw logic_error("enqueue_bulk copies the elements");
+    }
+
+    /**
+     * Removes up to n elements from the front of the queue, front first
+     * The default implementation calls try_dequeue for each element
+     * @param values Receives the dequeued elements
+     * @param n The maximum number of elements to dequeue
+     * @return The number of elements dequeued (less than n if the queue ran empty)
+     */
+    virtual int dequeue_bulk(T *values, int n)
+    {
+        int count = 0;
+        while (count < n && try_dequeue(values[count]))
+            count++;
+        return count;
+    }
+
     /**
      * Virtual destructor
      */
@@ -62,95 +280,251 @@ public:
 };
 
 /**
- * ArrayQueue - Implementation of Queue ADT using a dynamic array
- * Provides efficient queue operations with automatic resizing when needed
+ * QueueInterface - Base class of a queue implementation Self that can be used either way:
+ * through the virtual Queue<T> interface if Virtual is true, or on its own with every call
+ * resolved at compile time (and no vtable) if Virtual is false.
  */
-class ArrayQueue : public Queue
+template <typename Self, typename T, bool Virtual>
+using QueueInterface = typename conditional<Virtual, Queue<T>, QueueOperations<Self, T>>::type;
+
+#include "arrayqueue.hpp"
+#include "listqueue.hpp"
+#include "multilanequeue.hpp"
+
+#define CACHE_LINE_SIZE 64 // Members written by different threads are kept this far apart
+
+/**
+ * SpscQueue - Bounded lock-free queue for exactly one producer thread and one consumer thread
+ * The elements live in a ring buffer whose capacity is a power of two. head and tail count
+ * every dequeue and enqueue ever made, so the slot of a counter is counter & mask, and each
+ * of them is written by one thread only and sits on its own cache line. Each thread also keeps
+ * its last view of the other counter, so it only reads the shared line when that view runs out.
+ *
+ * enqueue, try_enqueue and back may only be called by the producer; dequeue, try_dequeue,
+ * front and clear by the consumer. size and empty may be called by either, and toString
+ * only while no other thread uses the queue.
+ */
+class SpscQueue : public Queue<int>
 {
 private:
-    int *data;     // Pointer to dynamically allocated array
-    int capacity;  // Maximum number of elements the array can currently hold
-    int front_idx; // Index of the front element
-    int rear_idx;  // Index of the rear element
+    int *slots;  // Ring buffer of mask + 1 elements
+    size_t mask; // Capacity - 1
+
+    alignas(CACHE_LINE_SIZE) atomic<size_t> head; // Number of dequeues, written by the consumer
+    size_t cached_tail;                           // Consumer's last view of tail
+
+    alignas(CACHE_LINE_SIZE) atomic<size_t> tail; // Number of enqueues, written by the producer
+    size_t cached_head;                           // Producer's last view of head
 
 public:
     /**
      * Constructor
-     * @param capacity Initial capacity of the queue (default: 2)
+     * @param capacity Maximum number of elements, rounded up to a power of two (default: 1024)
      */
-    ArrayQueue(int capacity = 2);
+    SpscQueue(int capacity = 1024);
 
     /**
      * Destructor - Cleans up any dynamically allocated memory
      */
-    ~ArrayQueue();
+    ~SpscQueue();
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
 
     // Queue interface implementation
+    // enqueue waits (yielding the thread) while the queue is full
     void enqueue(int value) override;
-    int dequeue() override;
+    bool try_dequeue(int &value) override;
     void clear() override;
-    int front() const override;
-    int back() const override;
+    const int *peek_front() const override;
+    const int *peek_back() const override;
     bool empty() const override;
     int size() const override;
     string toString() const override;
 
-    // Additional method to get the current capacity of the queue
-    int getCapacity() const;
+    /**
+     * Enqueues value unless the queue is full
+     * @return true if value was enqueued
+     */
+    bool try_enqueue(int value);
+
+    // Copy as many elements at once as there is room for (or elements), then publish them with one store
+    // enqueue_bulk waits while the queue is full; dequeue_bulk returns as soon as it is empty
+    void enqueue_bulk(const int *values, int n) override;
+    int dequeue_bulk(int *values, int n) override;
 
-private:
     /**
-     * Resizes the internal array when it becomes full or too empty
-     * @param new_capacity The new capacity of the array
+     * Enqueues up to n elements without waiting
+     * @return The number of elements enqueued (less than n if the queue became full)
      */
-    void resize(int new_capacity);
+    int try_enqueue_bulk(const int *values, int n);
+
+    int getCapacity() const;
 };
 
 /**
- * ListQueue - Implementation of Queue ADT using a singly linked list
- * Provides efficient queue operations with dynamic memory allocation per element
+ * MpmcQueue - Bounded lock-free queue for any number of producer and consumer threads
+ * Dmitry Vyukov's array queue: every slot of the ring buffer carries a sequence number that
+ * tells whose turn it is. A producer may fill the slot of position pos once its sequence is pos,
+ * and then sets it to pos + 1; a consumer may empty it once its sequence is pos + 1, and then
+ * hands it to the producer of the next round by setting it to pos + capacity. Threads claim
+ * positions with a compare-and-swap on enqueue_pos or dequeue_pos, so there are no locks.
+ * The slots are allocated once, so no memory is reclaimed while other threads may use it.
+ *
+ * enqueue, dequeue, try_enqueue, try_dequeue, clear, size, empty, front and back may be called
+ * from any thread at any time; toString only gives a consistent answer while no other thread
+ * modifies the queue. peek_front and peek_back copy the element and read the sequence of its slot
+ * again afterwards, retrying if another thread took or refilled the slot in between (like a
+ * seqlock). They return a pointer to a thread-local copy, valid until the same thread peeks again.
+ * An element counts once its producer has finished writing it: peek_back skips positions that are
+ * claimed but not yet written, and peek_front finds the queue empty while its front one is.
  */
-class ListQueue : public Queue
+class MpmcQueue : public Queue<int>
 {
 private:
     /**
-     * Node - Structure representing a single element in the linked list
+     * Cell - One slot of the ring buffer
      */
-    struct Node
+    struct Cell
     {
-        int data;   // Value stored in this node
-        Node *next; // Pointer to the next node in the list
-
-        /**
-         * Node constructor
-         * @param value The value to store in this node
-         * @param next_node Pointer to the next node (default: nullptr)
-         */
-        Node(int value, Node *next_node = nullptr) : data(value), next(next_node) {}
+        atomic<size_t> sequence; // Position the slot is waiting for (see above)
+        atomic<int> data;        // Value stored in this slot; atomic because peeks read it unclaimed
     };
 
-    Node *front_node; // Pointer to the front node of the queue
-    Node *rear_node;  // Pointer to the rear node of the queue
-    int current_size; // Number of elements currently in the queue
+    Cell *cells; // Ring buffer of mask + 1 slots
+    size_t mask; // Capacity - 1
+
+    alignas(CACHE_LINE_SIZE) atomic<size_t> enqueue_pos; // Next position to fill
+    alignas(CACHE_LINE_SIZE) atomic<size_t> dequeue_pos; // Next position to empty
 
 public:
     /**
-     * Constructor - Creates an empty queue
+     * Constructor
+     * @param capacity Maximum number of elements, rounded up to a power of two (default: 1024)
      */
-    ListQueue();
+    MpmcQueue(int capacity = 1024);
 
     /**
      * Destructor - Cleans up any dynamically allocated memory
      */
-    ~ListQueue();
+    ~MpmcQueue();
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
 
     // Queue interface implementation
+    // enqueue waits (yielding the thread) while the queue is full
     void enqueue(int value) override;
-    int dequeue() override;
+    bool try_dequeue(int &value) override;
     void clear() override;
-    int front() const override;
-    int back() const override;
+    const int *peek_front() const override;
+    const int *peek_back() const override;
     bool empty() const override;
     int size() const override;
     string toString() const override;
+
+    /**
+     * Enqueues value unless the queue is full
+     * @return true if value was enqueued
+     */
+    bool try_enqueue(int value);
+
+    int getCapacity() const;
 };
+
+/**
+ * BlockingQueue - Bounded queue for any number of threads, where producers wait while it is
+ * full and consumers wait while it is empty
+ * The elements are kept in an ArrayQueue guarded by a mutex. Threads wait on condition
+ * variables, and a change only wakes as many waiting threads as it can satisfy (one per
+ * element added or removed), so a single push does not wake every blocked consumer.
+ *
+ * close() ends the queue: pushes fail from then on, while pops keep returning the remaining
+ * elements (draining the queue) and fail once it is empty, which releases every waiting thread.
+ *
+ * Other threads may dequeue at any time, so peek_front and peek_back copy the element while
+ * holding the lock and return a pointer to a thread-local copy (valid until the thread peeks again).
+ */
+class BlockingQueue : public Queue<int>
+{
+private:
+    ArrayQueue<int> elements;    // Guarded by lock
+    int capacity;                // Maximum number of elements
+    bool closed;                 // Set by close()
+    int waiting_producers;       // Threads waiting in not_full
+    int waiting_consumers;       // Threads waiting in not_empty
+    mutable mutex lock;
+    condition_variable not_full;
+    condition_variable not_empty;
+
+    // Wake up to count waiting producers or consumers (called after unlocking)
+    void wake(condition_variable &condition, int count);
+
+    // Dequeues the front element into value unless the queue is empty, then unlocks guard
+    // and wakes a waiting producer
+    bool take_front(unique_lock<mutex> &guard, int &value);
+
+public:
+    /**
+     * Constructor
+     * @param capacity Maximum number of elements (default: 1024)
+     */
+    BlockingQueue(int capacity = 1024);
+
+    BlockingQueue(const BlockingQueue &) = delete;
+    BlockingQueue &operator=(const BlockingQueue &) = delete;
+
+    // Queue interface implementation
+    // enqueue is push_wait (ignoring the value once closed); try_dequeue is try_pop
+    void enqueue(int value) override;
+    bool try_dequeue(int &value) override;
+    void clear() override;
+    const int *peek_front() const override;
+    const int *peek_back() const override;
+    bool empty() const override;
+    int size() const override;
+    string toString() const override;
+    void enqueue_bulk(const int *values, int n) override; // Waits until every element is enqueued
+    int dequeue_bulk(int *values, int n) override;        // Takes what is there without waiting
+
+    /**
+     * Enqueues value, waiting while the queue is full
+     * @return false if the queue is (or gets) closed, in which case value is not enqueued
+     */
+    bool push_wait(int value);
+
+    /**
+     * Enqueues value unless the queue is full or closed
+     * @return true if value was enqueued
+     */
+    bool try_push(int value);
+
+    /**
+     * Dequeues the front element into value, waiting while the queue is empty
+     * @return false if the queue is closed and empty
+     */
+    bool pop_wait(int &value);
+
+    /**
+     * Like pop_wait, but gives up after timeout
+     * @return false if the queue stayed empty for timeout, or is closed and empty
+     */
+    bool try_pop_for(int &value, chrono::nanoseconds timeout);
+
+    /**
+     * Dequeues the front element into value unless the queue is empty
+     * @return true if an element was dequeued
+     */
+    bool try_pop(int &value);
+
+    /**
+     * Closes the queue and wakes every waiting thread
+     */
+    void close();
+
+    bool is_closed() const;
+
+    int getCapacity() const;
+};
+
+#include "workstealingdeque.hpp"
@@ -0,0 +1,195 @@
+#include "scheduler.h"
+#include <cassert>
+
+using namespace std;
+
+#define SPIN_ROUNDS 64 // Failed searches for a task before an idle worker goes to sleep
+
+thread_local TaskScheduler *TaskScheduler::current_scheduler = nullptr;
+thread_local int TaskScheduler::current_worker = -1;
+
+// Constructor implementation
+TaskScheduler::TaskScheduler(int threads)
+{
+    if (threads <= 0) {
+        threads = max(1, (int)thread::hardware_concurrency());
+    }
+    injected_count.store(0, memory_order_relaxed);
+    pending.store(0, memory_order_relaxed);
+    sleeping.store(0, memory_order_relaxed);
+    steals.store(0, memory_order_relaxed);
+    stopping = false;
+
+    // Every deque exists before any worker starts stealing from it
+    for (int i = 0; i < threads; i++)
+    {
+        workers.emplace_back(new Worker());
+        workers.back()->victim = i + 1;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i]->runner = thread(&TaskScheduler::run, this, i);
+    }
+}
+
+// Destructor implementation
+TaskScheduler::~TaskScheduler()
+{
+    wait();
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto &worker : workers)
+    {
+        worker->runner.join();
+    }
+}
+
+// Submit implementation
+void TaskScheduler::submit(Task task)
+{
+    Task *node = new Task(std::move(task));
+    pending.fetch_add(1, memory_order_relaxed);
+
+    if (current_scheduler == this)
+    {
+        // Submitted by a running task: only its own worker pushes to this deque
+        workers[current_worker]->tasks.push(node);
+
+        // Pairs with the fence in run: either a worker going to sleep sees the task, or we see it sleeping
+        atomic_thread_fence(memory_order_seq_cst);
+        if (sleeping.load(memory_order_relaxed) > 0)
+        {
+            // Under the lock, so the notification cannot fall between its last look and its wait
+            lock_guard<mutex> guard(lock);
+            wakeup.notify_one();
+        }
+    }
+    else
+    {
+        // A worker only goes to sleep while holding the lock, after seeing injected empty
+        lock_guard<mutex> guard(lock);
+        injected.enqueue(node);
+        injected_count.fetch_add(1, memory_order_relaxed);
+        if (sleeping.load(memory_order_relaxed) > 0) {
+            wakeup.notify_one();
+        }
+    }
+}
+
+// Wait implementation
+void TaskScheduler::wait()
+{
+    assert(current_scheduler != this);
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this]() { return pending.load(memory_order_acquire) == 0; });
+}
+
+// Find task implementation
+bool TaskScheduler::find_task(int index, Task *&task)
+{
+    Worker &self = *workers[index];
+    if (self.tasks.pop(task)) {
+        return true;
+    }
+
+    if (injected_count.load(memory_order_relaxed) > 0)
+    {
+        lock_guard<mutex> guard(lock);
+        if (injected.try_dequeue(task))
+        {
+            injected_count.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Visit the other workers once, starting after the last victim so the steals spread out
+    int n = workers.size();
+    for (int i = 0; i < n; i++)
+    {
+        int victim = (self.victim + i) % n;
+        if (victim == index) {
+            continue;
+        }
+        if (workers[victim]->tasks.steal(task))
+        {
+            self.victim = victim;
+            steals.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    self.victim++;
+    return false;
+}
+
+// Has work implementation
+bool TaskScheduler::has_work()
+{
+    if (!injected.empty()) {
+        return true;
+    }
+    for (auto &worker : workers)
+    {
+        if (!worker->tasks.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run implementation (the loop of a worker thread)
+void TaskScheduler::run(int index)
+{
+    current_scheduler = this;
+    current_worker = index;
+
+    int failed = 0;
+    while (true)
+    {
+        Task *task;
+        if (find_task(index, task))
+        {
+            failed = 0;
+            (*task)();
+            delete task;
+
+            if (pending.fetch_sub(1, memory_order_acq_rel) == 1)
+            {
+                // Lock so the notification cannot fall between wait's check and its sleep
+                lock_guard<mutex> guard(lock);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        if (++failed < SPIN_ROUNDS)
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        unique_lock<mutex> guard(lock);
+        if (stopping) {
+            return;
+        }
+        sleeping.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst); // Pairs with the fence in submit
+        if (!has_work()) {
+            wakeup.wait(guard); // Until submit or the destructor notifies (or a spurious wakeup)
+        }
+        sleeping.fetch_sub(1, memory_order_relaxed);
+        failed = 0;
+    }
+}
+
+int TaskScheduler::getThreadCount() const
+{
+    return workers.size();
+}
+
+long long TaskScheduler::getStealCount() const
+{
+    return steals.load(memory_order_relaxed);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "queue.h"
+using namespace std;
+
+/**
+ * TaskScheduler - Thread pool that balances fine-grained tasks with work stealing
+ * Every worker thread owns a WorkStealingDeque. A task submitted by a running task goes to the
+ * bottom of its worker's deque, so a worker keeps running the tasks it created (which are still
+ * in its cache) without touching shared state. A worker that runs out of tasks steals the
+ * oldest task of another worker, which is usually the root of a large piece of work. Tasks
+ * submitted from outside the pool go to a shared ArrayQueue guarded by a mutex.
+ *
+ * An idle worker yields for a while before it sleeps on a condition variable until a task is
+ * submitted. It counts itself in sleeping before it looks for work one last time, and submit
+ * checks sleeping after it publishes a task (with a seq_cst fence on both sides), so either the
+ * worker finds the task or the submitter sees the sleeper and wakes it; no task waits for a timeout.
+ */
+class TaskScheduler
+{
+public:
+    typedef function<void()> Task;
+
+private:
+    /**
+     * Worker - A worker thread and the tasks it owns
+     */
+    struct Worker
+    {
+        WorkStealingDeque<Task *> tasks; // Only this worker pushes and pops; the others steal
+        thread runner;
+        unsigned victim;                 // Where the next search for a task to steal starts
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    ArrayQueue<Task *> injected;       // Tasks submitted from outside the pool, guarded by lock
+    atomic<int> injected_count;        // Size of injected, readable without the lock
+    atomic<int> pending;               // Tasks submitted but not finished yet
+    atomic<int> sleeping;              // Workers waiting in wakeup
+    atomic<long long> steals;          // Tasks taken from another worker's deque
+    bool stopping;                     // Set by the destructor, guarded by lock
+    mutex lock;
+    condition_variable wakeup;         // Signalled when there is a task to run (or stopping is set)
+    condition_variable idle;           // Signalled when pending drops to 0
+
+    // The scheduler and worker index of the calling thread (nullptr and -1 outside of every pool)
+    static thread_local TaskScheduler *current_scheduler;
+    static thread_local int current_worker;
+
+    // Main loop of worker index
+    void run(int index);
+
+    // Takes the next task for worker index: its own newest task, then an injected one, then a stolen one
+    bool find_task(int index, Task *&task);
+
+    // Whether any deque or the injected queue holds a task; called with lock held
+    bool has_work();
+
+public:
+    /**
+     * Constructor - Starts the worker threads
+     * @param threads Number of worker threads (default: one per hardware thread)
+     */
+    TaskScheduler(int threads = 0);
+
+    /**
+     * Destructor - Waits for every task to finish and stops the workers
+     */
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    /**
+     * Schedules task to run on one of the worker threads
+     * May be called from any thread, including from a running task
+     */
+    void submit(Task task);
+
+    /**
+     * Waits until every submitted task has finished, including the tasks they submitted
+     * Must not be called from a task of this scheduler (the task would be waiting for itself)
+     */
+    void wait();
+
+    int getThreadCount() const;
+
+    /**
+     * Returns the number of tasks that ran on another worker than the one that submitted them
+     */
+    long long getStealCount() const;
+};
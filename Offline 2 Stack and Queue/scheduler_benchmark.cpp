@@ -0,0 +1,177 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "queue.h"
+#include "scheduler.h"
+using namespace std;
+
+/*
+g++ -O2 -pthread scheduler_benchmark.cpp scheduler.cpp
+./a.out <tree_depth>
+
+Runs a binary tree of tasks (every task submits its two children, the 2^depth leaves do a
+little arithmetic) and as many independent tasks as the tree has leaves, submitted from the
+main thread. Both run on the work-stealing TaskScheduler and on a pool whose threads share one
+ArrayQueue guarded by a mutex; prints the throughput of each in millions of tasks per second.
+*/
+
+/**
+ * LockedPool - The baseline: every submit and every take goes through one mutex and one queue
+ */
+class LockedPool
+{
+private:
+    typedef function<void()> Task;
+
+    ArrayQueue<Task *> tasks; // Guarded by lock
+    vector<thread> workers;
+    int pending;              // Tasks submitted but not finished, guarded by lock
+    bool stopping;            // Guarded by lock
+    mutex lock;
+    condition_variable wakeup;
+    condition_variable idle;
+
+    void run()
+    {
+        unique_lock<mutex> guard(lock);
+        while (true)
+        {
+            wakeup.wait(guard, [this]() { return stopping || !tasks.empty(); });
+            Task *task;
+            if (!tasks.try_dequeue(task))
+                return; // Stopping and nothing left to run
+            guard.unlock();
+            (*task)();
+            delete task;
+            guard.lock();
+            if (--pending == 0)
+                idle.notify_all();
+        }
+    }
+
+public:
+    LockedPool(int threads)
+    {
+        pending = 0;
+        stopping = false;
+        for (int i = 0; i < threads; i++)
+            workers.emplace_back(&LockedPool::run, this);
+    }
+
+    ~LockedPool()
+    {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    void submit(Task task)
+    {
+        Task *node = new Task(std::move(task));
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.enqueue(node);
+            pending++;
+        }
+        wakeup.notify_one();
+    }
+
+    void wait()
+    {
+        unique_lock<mutex> guard(lock);
+        idle.wait(guard, [this]() { return pending == 0; });
+    }
+};
+
+atomic<long long> checksum(0);
+
+// The work of a leaf: small enough that the cost of scheduling it dominates
+void leaf_work(int seed)
+{
+    long long x = seed;
+    for (int i = 0; i < 50; i++)
+        x = x * 6364136223846793005LL + 1442695040888963407LL;
+    checksum.fetch_add(x & 1, memory_order_relaxed);
+}
+
+template <typename Pool>
+void spawn_tree(Pool &pool, int depth, int seed)
+{
+    if (depth == 0)
+    {
+        leaf_work(seed);
+        return;
+    }
+    pool.submit([&pool, depth, seed]() { spawn_tree(pool, depth - 1, 2 * seed); });
+    pool.submit([&pool, depth, seed]() { spawn_tree(pool, depth - 1, 2 * seed + 1); });
+}
+
+// Returns the throughput of running a task tree of the given depth (2^(depth + 1) - 1 tasks)
+template <typename Pool>
+double measure_tree(Pool &pool, int depth)
+{
+    auto start = chrono::steady_clock::now();
+    pool.submit([&pool, depth]() { spawn_tree(pool, depth, 1); });
+    pool.wait();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return ((2LL << depth) - 1) / elapsed.count() / 1e6;
+}
+
+// Returns the throughput of running n independent tasks submitted from this thread
+template <typename Pool>
+double measure_flat(Pool &pool, int n)
+{
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        pool.submit([i]() { leaf_work(i); });
+    pool.wait();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return n / elapsed.count() / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    int depth = 18;
+    if (argc > 1)
+    {
+        depth = atoi(argv[1]);
+        if (depth < 4 || depth > 24)
+        {
+            cout << "Invalid tree depth. Using default value of 18.\n";
+            depth = 18;
+        }
+    }
+    // Powers of two up to the number of hardware threads, and that number itself
+    int max_threads = max(1, (int)thread::hardware_concurrency());
+    vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    cout << "pool,threads,workload,Mtasks_per_s\n";
+    for (int threads : thread_counts)
+    {
+        {
+            TaskScheduler scheduler(threads);
+            cout << "TaskScheduler," << threads << ",tree," << measure_tree(scheduler, depth) << endl;
+            cout << "TaskScheduler," << threads << ",flat," << measure_flat(scheduler, 1 << depth) << endl;
+        }
+        {
+            LockedPool pool(threads);
+            cout << "ArrayQueue+mutex," << threads << ",tree," << measure_tree(pool, depth) << endl;
+            cout << "ArrayQueue+mutex," << threads << ",flat," << measure_flat(pool, 1 << depth) << endl;
+        }
+    }
+
+    return 0;
+}
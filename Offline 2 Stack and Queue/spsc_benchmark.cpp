@@ -0,0 +1,109 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include "queue.h"
+using namespace std;
+
+/*
+g++ -O2 -pthread spsc_benchmark.cpp spscqueue.cpp arrayqueue.cpp
+./a.out <number_of_elements>
+
+Moves the elements 0 ... n - 1 from a producer thread to a consumer thread, through an
+SpscQueue of several capacities and through an ArrayQueue guarded by a mutex, and prints
+the throughput of each in millions of elements per second.
+*/
+
+// Returns the throughput of moving n elements through queue with one producer and one consumer thread
+double measure_spsc(SpscQueue &queue, int n)
+{
+    auto start = chrono::steady_clock::now();
+    thread producer([&]()
+                    {
+        for (int i = 0; i < n; i++)
+            queue.enqueue(i); });
+
+    long long sum = 0;
+    int value;
+    for (int received = 0; received < n;)
+    {
+        if (queue.try_dequeue(value))
+        {
+            sum += value;
+            received++;
+        }
+        else
+            this_thread::yield();
+    }
+    producer.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (sum != (long long)n * (n - 1) / 2)
+        cerr << "SpscQueue lost or duplicated elements\n";
+    return n / elapsed.count() / 1e6;
+}
+
+// Same as measure_spsc, but every operation on the ArrayQueue holds a lock
+double measure_locked(int n)
+{
+    ArrayQueue<int> queue;
+    mutex lock;
+
+    auto start = chrono::steady_clock::now();
+    thread producer([&]()
+                    {
+        for (int i = 0; i < n; i++)
+        {
+            lock_guard<mutex> guard(lock);
+            queue.enqueue(i);
+        } });
+
+    long long sum = 0;
+    for (int received = 0; received < n;)
+    {
+        bool got = false;
+        {
+            lock_guard<mutex> guard(lock);
+            if (!queue.empty())
+            {
+                sum += queue.dequeue();
+                got = true;
+            }
+        }
+        if (got)
+            received++;
+        else
+            this_thread::yield();
+    }
+    producer.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (sum != (long long)n * (n - 1) / 2)
+        cerr << "ArrayQueue lost or duplicated elements\n";
+    return n / elapsed.count() / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = 10000000;
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+        if (n < 1000)
+        {
+            cout << "Invalid number of elements. Using default value of 10000000.\n";
+            n = 10000000;
+        }
+    }
+
+    cout << "queue,capacity,Melem_per_s\n";
+    for (int capacity : {64, 1024, 65536})
+    {
+        SpscQueue queue(capacity);
+        cout << "SpscQueue," << capacity << "," << measure_spsc(queue, n) << endl;
+    }
+    cout << "ArrayQueue+mutex,unbounded," << measure_locked(n) << endl;
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "queue.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+using namespace std;
+
+// Constructor implementation
+SpscQueue::SpscQueue(int capacity)
+{
+    size_t rounded = 2;
+    while (rounded < (size_t)capacity)
+    {
+        rounded *= 2;
+    }
+    slots = new int[rounded];
+    mask = rounded - 1;
+    head.store(0, memory_order_relaxed);
+    tail.store(0, memory_order_relaxed);
+    cached_tail = 0;
+    cached_head = 0;
+}
+
+// Destructor implementation
+SpscQueue::~SpscQueue()
+{
+    delete[] slots;
+}
+
+// Try enqueue implementation (producer only)
+bool SpscQueue::try_enqueue(int value)
+{
+    size_t t = tail.load(memory_order_relaxed);
+    if (t - cached_head > mask)
+    {
+        // Full as far as we know: the consumer may have made room since
+        cached_head = head.load(memory_order_acquire);
+        if (t - cached_head > mask) {
+            return false;
+        }
+    }
+
+    slots[t & mask] = value;
+    tail.store(t + 1, memory_order_release); // Publishes the slot to the consumer
+    return true;
+}
+
+// Try dequeue implementation (consumer only)
+bool SpscQueue::try_dequeue(int &value)
+{
+    size_t h = head.load(memory_order_relaxed);
+    if (h == cached_tail)
+    {
+        // Empty as far as we know: the producer may have added elements since
+        cached_tail = tail.load(memory_order_acquire);
+        if (h == cached_tail) {
+            return false;
+        }
+    }
+
+    value = slots[h & mask];
+    head.store(h + 1, memory_order_release); // Hands the slot back to the producer
+    return true;
+}
+
+// Try bulk enqueue implementation (producer only)
+int SpscQueue::try_enqueue_bulk(const int *values, int n)
+{
+    size_t t = tail.load(memory_order_relaxed);
+    size_t free_slots = mask + 1 - (t - cached_head);
+    if (free_slots < (size_t)n)
+    {
+        cached_head = head.load(memory_order_acquire);
+        free_slots = mask + 1 - (t - cached_head);
+    }
+    int count = (int)min((size_t)max(n, 0), free_slots);
+    if (count == 0) {
+        return 0;
+    }
+
+    // The first part fills the buffer up to its end, the rest starts again at index 0
+    int start = (int)(t & mask);
+    int first_part = min(count, (int)(mask + 1) - start);
+    memcpy(slots + start, values, first_part * sizeof(int));
+    memcpy(slots, values + first_part, (count - first_part) * sizeof(int));
+    tail.store(t + count, memory_order_release); // Publishes all the slots at once
+    return count;
+}
+
+// Bulk enqueue implementation (waits for the consumer while the queue is full)
+void SpscQueue::enqueue_bulk(const int *values, int n)
+{
+    int done = 0;
+    while (done < n)
+    {
+        int count = try_enqueue_bulk(values + done, n - done);
+        if (count == 0) {
+            this_thread::yield();
+        }
+        done += count;
+    }
+}
+
+// Bulk dequeue implementation (consumer only)
+int SpscQueue::dequeue_bulk(int *values, int n)
+{
+    size_t h = head.load(memory_order_relaxed);
+    if (cached_tail - h < (size_t)n) {
+        cached_tail = tail.load(memory_order_acquire);
+    }
+    int count = (int)min((size_t)max(n, 0), cached_tail - h);
+    if (count == 0) {
+        return 0;
+    }
+
+    int start = (int)(h & mask);
+    int first_part = min(count, (int)(mask + 1) - start);
+    memcpy(values, slots + start, first_part * sizeof(int));
+    memcpy(values + first_part, slots, (count - first_part) * sizeof(int));
+    head.store(h + count, memory_order_release); // Hands all the slots back at once
+    return count;
+}
+
+// Enqueue implementation (waits for the consumer while the queue is full)
+void SpscQueue::enqueue(int item)
+{
+    while (!try_enqueue(item))
+    {
+        this_thread::yield();
+    }
+}
+
+// Clear implementation (drops every element the consumer can see)
+void SpscQueue::clear()
+{
+    cached_tail = tail.load(memory_order_acquire);
+    head.store(cached_tail, memory_order_release);
+}
+
+// Size implementation
+int SpscQueue::size() const
+{
+    // head is read first, so that tail is never behind it
+    size_t h = head.load(memory_order_acquire);
+    size_t t = tail.load(memory_order_acquire);
+    return (int)(t - h);
+}
+
+// Peek front implementation (consumer only; the slot is not reused before the consumer dequeues it)
+const int *SpscQueue::peek_front() const
+{
+    size_t h = head.load(memory_order_relaxed);
+    if (h == tail.load(memory_order_acquire)) {
+        return nullptr;
+    }
+    return &slots[h & mask];
+}
+
+// Peek back implementation (producer only)
+const int *SpscQueue::peek_back() const
+{
+    size_t t = tail.load(memory_order_relaxed);
+    if (head.load(memory_order_acquire) == t) {
+        return nullptr;
+    }
+    return &slots[(t - 1) & mask];
+}
+
+// Empty implementation
+bool SpscQueue::empty() const
+{
+    return size() == 0;
+}
+
+// Print implementation in the format: <elem1, elem2, ..., elemN|
+string SpscQueue::toString() const
+{
+    size_t h = head.load(memory_order_acquire);
+    size_t t = tail.load(memory_order_acquire);
+    string result = "<";
+    for (size_t i = h; i != t; i++)
+    {
+        result += to_string(slots[i & mask]);
+        if (i + 1 != t)
+        {
+            result += ", ";
+        }
+    }
+    result += "|";
+    return result;
+}
+
+int SpscQueue::getCapacity() const
+{
+    return (int)(mask + 1);
+}
@@ -0,0 +1,264 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include "queue.h"
+using namespace std;
+
+/*
+g++ -pthread spscqueue_tester.cpp spscqueue.cpp
+.\a.exe <number_of_tests>
+*/
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    SpscQueue *my_queue = new SpscQueue(64);
+    queue<int> stl_queue;
+
+    {
+        cout << "Initializing queue with random elements...\n";
+        int initial_size = rand() % 20 + 1; // Random initial size between 1 and 10
+        for (int i = 0; i < initial_size; ++i)
+        {
+            int val = rand() % 100;
+            my_queue->enqueue(val);
+            stl_queue.push(val);
+        }
+        cout << "Initial queue: " << my_queue->toString() << endl
+             << endl;
+    }
+
+    int success_count = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        int op = rand() % 6; // Random operation
+
+        switch (op)
+        {
+        case 0:
+        {
+            cout << "Operation " << i + 1 << ": clear()";
+            my_queue->clear();
+            stl_queue = queue<int>();
+            if (my_queue->empty())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+
+            {
+                cout << "Reinitializing queue with random elements...\n";
+                int initial_size = rand() % 50 + 1; // Random initial size between 1 and 20
+                for (int i = 0; i < initial_size; ++i)
+                {
+                    int val = rand() % 100;
+                    my_queue->enqueue(val);
+                    stl_queue.push(val);
+                }
+            }
+        }
+        break;
+
+        case 1:
+        {
+            int val = rand() % 100;
+            cout << "Operation " << i + 1 << ": enqueue(" << val << ")";
+            bool enqueued = my_queue->try_enqueue(val);
+            bool full = (int)stl_queue.size() == my_queue->getCapacity();
+            if (!full)
+                stl_queue.push(val);
+
+            if (enqueued == !full && my_queue->back() == stl_queue.back())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+
+        break;
+
+        case 2:
+        {
+            int my_dequeued = my_queue->dequeue();
+
+            int stl_dequeued = -1;
+            if (!stl_queue.empty())
+            {
+                stl_dequeued = stl_queue.front();
+                stl_queue.pop();
+            }
+
+            cout << "Operation " << i + 1 << ": dequeue() -> MyQueue: " << my_dequeued << ", STL: " << stl_dequeued;
+            if (my_dequeued == stl_dequeued)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 3:
+        {
+            int my_front = my_queue->front();
+            int stl_front = -1;
+            if (!stl_queue.empty())
+            {
+                stl_front = stl_queue.front();
+            }
+            cout << "Operation " << i + 1 << ": front() -> MyQueue: " << my_front << ", STL: " << stl_front;
+            if (my_front == stl_front)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 4:
+        {
+            int my_back = my_queue->back();
+            int stl_back = -1;
+            if (!stl_queue.empty())
+            {
+                stl_back = stl_queue.back();
+            }
+            cout << "Operation " << i + 1 << ": back() -> MyQueue: " << my_back << ", STL: " << stl_back;
+            if (my_back == stl_back)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 5:
+        {
+            int my_size = my_queue->size();
+            int stl_size = stl_queue.size();
+            cout << "Operation " << i + 1 << ": size() -> MyQueue: " << my_size << ", STL: " << stl_size;
+            if (my_size == stl_size)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        default:
+            break;
+        }
+        cout << my_queue->toString() << endl
+             << endl;
+    }
+
+    delete my_queue;
+
+    {
+        // Bulk operations on a small ring, so their two copies keep meeting at the wrap point;
+        // try_enqueue_bulk stops when the ring is full
+        SpscQueue bulk_queue(16);
+        queue<int> stl_reference;
+        int values[24];
+        bool ok = true;
+        for (int j = 0; j < N * 10 && ok; ++j)
+        {
+            int n = rand() % 24;
+            for (int k = 0; k < n; ++k)
+                values[k] = rand() % 100;
+            if (rand() % 2 == 0)
+            {
+                int count = bulk_queue.try_enqueue_bulk(values, n);
+                ok = count == min(n, bulk_queue.getCapacity() - (int)stl_reference.size());
+                for (int k = 0; k < count; ++k)
+                    stl_reference.push(values[k]);
+            }
+            else
+            {
+                int count = bulk_queue.dequeue_bulk(values, n);
+                ok = count == min(n, (int)stl_reference.size());
+                for (int k = 0; k < count && ok; ++k)
+                {
+                    ok = values[k] == stl_reference.front();
+                    stl_reference.pop();
+                }
+            }
+            ok = ok && bulk_queue.size() == (int)stl_reference.size();
+            if (!stl_reference.empty())
+                ok = ok && bulk_queue.front() == stl_reference.front() && bulk_queue.back() == stl_reference.back();
+        }
+        cout << "Bulk test: " << N * 10 << " try_enqueue_bulk/dequeue_bulk calls on a queue of capacity " << bulk_queue.getCapacity();
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // One producer and one consumer thread; the consumer must see 0, 1, 2, ... in order
+        int M = N * 100;
+        SpscQueue shared_queue(16);
+        cout << "Concurrent test: " << M << " elements through a queue of capacity " << shared_queue.getCapacity();
+        thread producer([&]()
+                        {
+            for (int val = 0; val < M; ++val)
+                shared_queue.enqueue(val); });
+        int expected = 0;
+        int val;
+        while (expected < M)
+        {
+            if (shared_queue.try_dequeue(val))
+            {
+                if (val != expected)
+                    break;
+                expected++;
+            }
+            else
+                this_thread::yield();
+        }
+        producer.join();
+        N++;
+        if (expected == M && shared_queue.empty())
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+// Included from queue.h, after the concurrent queues
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * WorkStealingDeque - Unbounded lock-free deque with one owner thread and any number of thieves
+ * (the Chase-Lev deque, with the memory orderings of Le et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models")
+ * The owner pushes and pops at the bottom, like a stack, so it keeps working on the elements it
+ * added last; thieves steal from the top, taking the oldest elements. The two ends only compete
+ * for the last element, which is settled by a compare-and-swap on top.
+ * The elements live in a ring buffer whose capacity is a power of two; when it is full the owner
+ * copies them into a buffer twice as large. Thieves may still be reading the old buffer, so the
+ * replaced buffers are only freed by the destructor.
+ *
+ * push and pop may only be called by the owner; steal, size and empty by any thread.
+ * @tparam T The type of the elements, which must be trivially copyable (such as a pointer)
+ */
+template <typename T>
+class WorkStealingDeque
+{
+    static_assert(is_trivially_copyable<T>::value, "WorkStealingDeque copies the elements with atomic loads and stores");
+
+private:
+    /**
+     * Buffer - A ring buffer of atomic slots; position i is in slot i & mask
+     */
+    struct Buffer
+    {
+        ptrdiff_t mask;                   // Capacity - 1
+        unique_ptr<atomic<T>[]> slots;    // mask + 1 slots
+
+        Buffer(ptrdiff_t capacity) : mask(capacity - 1), slots(new atomic<T>[capacity]) {}
+
+        T get(ptrdiff_t position) const
+        {
+            return slots[position & mask].load(memory_order_relaxed);
+        }
+
+        void put(ptrdiff_t position, T value)
+        {
+            slots[position & mask].store(value, memory_order_relaxed);
+        }
+    };
+
+    alignas(CACHE_LINE_SIZE) atomic<ptrdiff_t> top; // Position of the oldest element, advanced by steal (and pop)
+    atomic<Buffer *> buffer;                         // Current ring buffer
+
+    alignas(CACHE_LINE_SIZE) atomic<ptrdiff_t> bottom; // Position after the newest element, written by the owner
+    vector<unique_ptr<Buffer>> buffers;                // Every buffer allocated so far, only used by the owner
+
+public:
+    /**
+     * Constructor
+     * @param capacity Initial capacity, rounded up to a power of two (default: 64)
+     */
+    WorkStealingDeque(int capacity = 64);
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    /**
+     * Adds value at the bottom, growing the buffer if it is full (owner only)
+     */
+    void push(T value);
+
+    /**
+     * Removes the newest element into value (owner only)
+     * @return false if the deque is empty (or a thief took its last element)
+     */
+    bool pop(T &value);
+
+    /**
+     * Removes the oldest element into value (any thread)
+     * @return false if the deque is empty, or another thread took the element first
+     */
+    bool steal(T &value);
+
+    /**
+     * Returns the number of elements, which may already be out of date when other threads use the deque
+     */
+    int size() const;
+
+    bool empty() const;
+
+    int getCapacity() const;
+};
+
+// Constructor implementation
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(int capacity)
+{
+    ptrdiff_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    buffers.emplace_back(new Buffer(rounded));
+    buffer.store(buffers.back().get(), memory_order_relaxed);
+    top.store(0, memory_order_relaxed);
+    bottom.store(0, memory_order_relaxed);
+}
+
+// Push implementation
+template <typename T>
+void WorkStealingDeque<T>::push(T value)
+{
+    ptrdiff_t b = bottom.load(memory_order_relaxed);
+    ptrdiff_t t = top.load(memory_order_acquire);
+    Buffer *current = buffer.load(memory_order_relaxed);
+
+    if (b - t > current->mask)
+    {
+        // The buffer is full: copy the elements to the same positions of a buffer twice as large
+        Buffer *grown = new Buffer(2 * (current->mask + 1));
+        for (ptrdiff_t i = t; i < b; i++) {
+            grown->put(i, current->get(i));
+        }
+        buffers.emplace_back(grown);
+        buffer.store(grown, memory_order_release);
+        current = grown;
+    }
+
+    current->put(b, value);
+    // Publishes the element (and a new buffer) to the thieves that see the new bottom
+    bottom.store(b + 1, memory_order_release);
+}
+
+// Pop implementation
+template <typename T>
+bool WorkStealingDeque<T>::pop(T &value)
+{
+    ptrdiff_t b = bottom.load(memory_order_relaxed) - 1;
+    Buffer *current = buffer.load(memory_order_relaxed);
+
+    // Claim the bottom element before looking at top; seq_cst orders the store before the load,
+    // so a thief either sees the new bottom or this thread sees the thief's top
+    bottom.store(b, memory_order_seq_cst);
+    ptrdiff_t t = top.load(memory_order_seq_cst);
+
+    if (t > b)
+    {
+        // Empty
+        bottom.store(b + 1, memory_order_relaxed);
+        return false;
+    }
+
+    value = current->get(b);
+    if (t == b)
+    {
+        // Last element: the thieves may be after it too, so take it from the top like they do
+        bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+        bottom.store(b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+// Steal implementation
+template <typename T>
+bool WorkStealingDeque<T>::steal(T &value)
+{
+    ptrdiff_t t = top.load(memory_order_seq_cst);
+    ptrdiff_t b = bottom.load(memory_order_seq_cst);
+    if (t >= b) {
+        return false;
+    }
+
+    // Read the element before claiming it: once top moves, the owner may overwrite the slot
+    value = buffer.load(memory_order_acquire)->get(t);
+    return top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+// Size implementation
+template <typename T>
+int WorkStealingDeque<T>::size() const
+{
+    ptrdiff_t b = bottom.load(memory_order_acquire);
+    ptrdiff_t t = top.load(memory_order_acquire);
+    return b > t ? (int)(b - t) : 0;
+}
+
+// Empty implementation
+template <typename T>
+bool WorkStealingDeque<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+int WorkStealingDeque<T>::getCapacity() const
+{
+    return (int)(buffer.load(memory_order_acquire)->mask + 1);
+}
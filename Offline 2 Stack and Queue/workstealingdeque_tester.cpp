@@ -0,0 +1,225 @@
+#include <iostream>
+#include <deque>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include "queue.h"
+#include "scheduler.h"
+using namespace std;
+
+/*
+g++ -pthread workstealingdeque_tester.cpp scheduler.cpp
+.\a.exe <number_of_tests>
+*/
+
+int main(int argc, char *argv[])
+{
+    int N = 10;
+    if (argc > 1)
+    {
+        N = atoi(argv[1]);
+        if (N <= 0)
+        {
+            cout << "Invalid number of tests. Using default value of 1.\n";
+            N = 10;
+        }
+    }
+    srand((unsigned)time(0));
+    // A small capacity, so the random operations also grow the buffer
+    WorkStealingDeque<int> *my_deque = new WorkStealingDeque<int>(4);
+    deque<int> stl_deque;
+
+    int success_count = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        int op = rand() % 5; // Random operation
+
+        switch (op)
+        {
+        case 0:
+        case 1:
+        {
+            int val = rand() % 100;
+            cout << "Operation " << i + 1 << ": push(" << val << ")";
+            my_deque->push(val);
+            stl_deque.push_back(val);
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        break;
+
+        case 2:
+        {
+            // The owner takes the newest element
+            int my_popped = -1;
+            my_deque->pop(my_popped);
+
+            int stl_popped = -1;
+            if (!stl_deque.empty())
+            {
+                stl_popped = stl_deque.back();
+                stl_deque.pop_back();
+            }
+
+            cout << "Operation " << i + 1 << ": pop() -> MyDeque: " << my_popped << ", STL: " << stl_popped;
+            if (my_popped == stl_popped)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 3:
+        {
+            // A thief takes the oldest element
+            int my_stolen = -1;
+            my_deque->steal(my_stolen);
+
+            int stl_stolen = -1;
+            if (!stl_deque.empty())
+            {
+                stl_stolen = stl_deque.front();
+                stl_deque.pop_front();
+            }
+
+            cout << "Operation " << i + 1 << ": steal() -> MyDeque: " << my_stolen << ", STL: " << stl_stolen;
+            if (my_stolen == stl_stolen)
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        case 4:
+        {
+            int my_size = my_deque->size();
+            int stl_size = stl_deque.size();
+            cout << "Operation " << i + 1 << ": size() -> MyDeque: " << my_size << ", STL: " << stl_size;
+            if (my_size == stl_size && my_deque->empty() == stl_deque.empty())
+            {
+                cout << " \033[32m[OK]\033[0m\n";
+                success_count++;
+            }
+            else
+                cout << " \033[31m[Mismatch!]\033[0m\n";
+        }
+        break;
+
+        default:
+            break;
+        }
+    }
+    cout << "Capacity: " << my_deque->getCapacity() << endl
+         << endl;
+
+    delete my_deque;
+
+    {
+        // The owner pushes and pops while several thieves steal, so the two ends keep racing
+        // for the last element; every element must be taken exactly once
+        const int THIEVES = 3;
+        int M = N * 100; // Elements pushed by the owner
+        WorkStealingDeque<int> shared_deque(2);
+        cout << "Steal test: owner pushes " << M << " elements, " << THIEVES << " thieves";
+
+        vector<atomic<int>> taken(M); // Zero-initialized
+        atomic<int> remaining(M);
+        vector<thread> thieves;
+        for (int t = 0; t < THIEVES; ++t)
+        {
+            thieves.emplace_back([&]()
+                                 {
+                int val;
+                while (remaining.load() > 0)
+                {
+                    if (shared_deque.steal(val))
+                    {
+                        taken[val]++;
+                        remaining--;
+                    }
+                    else
+                        this_thread::yield();
+                } });
+        }
+
+        int val;
+        for (int i = 0; i < M; ++i)
+        {
+            shared_deque.push(i);
+            if (i % 3 == 0 && shared_deque.pop(val))
+            {
+                taken[val]++;
+                remaining--;
+            }
+        }
+        while (remaining.load() > 0)
+        {
+            if (shared_deque.pop(val))
+            {
+                taken[val]++;
+                remaining--;
+            }
+        }
+        for (thread &t : thieves)
+            t.join();
+
+        bool ok = shared_deque.empty() && remaining.load() == 0;
+        for (int i = 0; i < M; ++i)
+            ok = ok && taken[i] == 1;
+
+        N++;
+        if (ok)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    {
+        // Tasks that submit tasks: a binary tree of the given depth must run every leaf exactly once
+        int depth = 10, trees = N;
+        atomic<long long> leaves(0);
+        TaskScheduler scheduler(4);
+        cout << "Scheduler test: task tree of depth " << depth << " on " << scheduler.getThreadCount() << " threads";
+
+        function<void(int)> spawn = [&](int level)
+        {
+            if (level == 0)
+            {
+                leaves++;
+                return;
+            }
+            scheduler.submit([&, level]() { spawn(level - 1); });
+            scheduler.submit([&, level]() { spawn(level - 1); });
+        };
+        for (int i = 0; i < trees; ++i)
+            scheduler.submit([&]() { spawn(depth); });
+        scheduler.wait();
+
+        N++;
+        if (leaves.load() == (long long)trees << depth)
+        {
+            cout << " \033[32m[OK]\033[0m\n";
+            success_count++;
+        }
+        else
+            cout << " \033[31m[Mismatch!]\033[0m\n";
+    }
+
+    if (success_count == N)
+        cout << "\033[32mAll operations passed!\033[0m\n";
+    else
+        cout << "\033[31mSome operations failed.\033[0m\n";
+    return 0;
+}
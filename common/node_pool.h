@@ -0,0 +1,150 @@
+#pragma once
+#include <new>
+#include <utility>
+
+/**
+ * Node allocation policies shared by the linked structures of the offlines.
+ * A policy creates and destroys nodes of a single type:
+ *     Node *create(args...)  - constructs a node from the given arguments
+ *     void destroy(Node *)   - destroys a node created by this allocator
+ *     void release_all()     - frees every node at once (only if releases_in_bulk)
+ *     void adopt(other)      - takes over the nodes of another allocator of the same type,
+ *                              so that they can be linked into this structure
+ */
+
+/**
+ * HeapAllocator - Allocates every node separately with new and delete
+ */
+template <typename Node>
+class HeapAllocator
+{
+public:
+    static const bool releases_in_bulk = false;
+
+    template <typename... Args>
+    Node *create(Args &&...args)
+    {
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node)
+    {
+        delete node;
+    }
+
+    void release_all() {}
+
+    void adopt(HeapAllocator &) {}
+};
+
+/**
+ * NodePool - Carves nodes out of contiguous slabs of SlabSize nodes
+ * Destroyed nodes are kept in a free list and recycled by the next create(),
+ * so a steady stream of inserts and deletes does not reach malloc at all.
+ * release_all() frees the slabs without running destructors, so it must only
+ * be called once none of the nodes are in use (and Node is trivially destructible).
+ */
+template <typename Node, int SlabSize = 256>
+class NodePool
+{
+    union Slot
+    {
+        Slot *next_free;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    struct Slab
+    {
+        Slab *next;
+        Slot slots[SlabSize];
+    };
+
+    Slab *slabs;     // Most recently allocated slab first
+    Slab *last_slab; // Oldest slab, where adopted slabs are appended
+    Slot *free_list; // Destroyed nodes waiting to be reused
+    int used_slots;  // Number of slots handed out from the first slab
+
+public:
+    static const bool releases_in_bulk = true;
+
+    NodePool() : slabs(nullptr), last_slab(nullptr), free_list(nullptr), used_slots(SlabSize) {}
+
+    ~NodePool()
+    {
+        release_all();
+    }
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    template <typename... Args>
+    Node *create(Args &&...args)
+    {
+        Slot *slot;
+        if (free_list != nullptr)
+        {
+            slot = free_list;
+            free_list = slot->next_free;
+        }
+        else
+        {
+            if (used_slots == SlabSize)
+            {
+                Slab *slab = new Slab;
+                slab->next = slabs;
+                slabs = slab;
+                if (last_slab == nullptr)
+                    last_slab = slab;
+                used_slots = 0;
+            }
+            slot = &slabs->slots[used_slots++];
+        }
+        return new (slot->storage) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node)
+    {
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->next_free = free_list;
+        free_list = slot;
+    }
+
+    void release_all()
+    {
+        while (slabs != nullptr)
+        {
+            Slab *next = slabs->next;
+            delete slabs;
+            slabs = next;
+        }
+        last_slab = nullptr;
+        free_list = nullptr;
+        used_slots = SlabSize;
+    }
+
+    // Takes over the slabs of other in O(1), leaving it empty.
+    // The free and unused slots of other are not reused, but freed with the slabs.
+    void adopt(NodePool &other)
+    {
+        if (other.slabs == nullptr)
+            return;
+
+        if (slabs == nullptr)
+        {
+            slabs = other.slabs;
+            last_slab = other.last_slab;
+            free_list = other.free_list;
+            used_slots = other.used_slots;
+        }
+        else
+        {
+            last_slab->next = other.slabs;
+            last_slab = other.last_slab;
+        }
+        other.slabs = nullptr;
+        other.last_slab = nullptr;
+        other.free_list = nullptr;
+        other.used_slots = SlabSize;
+    }
+};